@@ -0,0 +1,97 @@
+/*****************************************************************************
+ * @file    sample_cpp.cpp
+ * @author  Kshitij Mistry
+ * @brief   Sample main function for C++ layer of scheduler module.
+ *
+ * This file contains the main function for a sample C++ application that registers
+ * lambda and member function as scheduler task and task timer through scheduler.hpp.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_def.h"
+#include "common_utils.h"
+#include "scheduler.hpp"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Smallest timer tick used to schedule tasks in millisec */
+#define	TIMER_TICK_RESOLUTION_IN_MS (10)
+
+/*****************************************************************************
+ * CLASSES
+ *****************************************************************************/
+/**
+ * @brief   Sample device which polls itself and restarts idle timer on activity
+ */
+class SampleDevice
+{
+public:
+    explicit SampleDevice(const cChar *name)
+        : name_(name), poll_([this] { Poll(); }), idle_([this] { IPRINT("%s: idle timeout", name_); })
+    {
+    }
+
+    void Start()
+    {
+        poll_.Register(TIME_INTERVAL_100MS);
+        idle_.Start(2000, 200);
+    }
+
+private:
+    void Poll()
+    {
+        if ((++pollCnt_ % 10) == 0)
+        {
+            IPRINT("%s: polled [%u] times", name_, pollCnt_);
+        }
+    }
+
+    const cChar *name_;
+    cU32_t pollCnt_ = 0;
+    scheduler::Task<> poll_;
+    scheduler::Timer<> idle_;
+};
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+/**
+ * @brief This is main function of C++ scheduler example
+ * @return 0 if successfully exited else -1 on error occurs
+ */
+int main()
+{
+    cU32_t maxPermittedDelayMs = 1000;
+
+    if (c_FALSE == Scheduler_Init(TIMER_TICK_RESOLUTION_IN_MS, &maxPermittedDelayMs))
+    {
+        EPRINT("failed to initialize scheduler");
+        return (-1);
+    }
+
+    TaskTimer_Init();
+    Scheduler_RegisterTask(TaskTimer_Tick, TIME_INTERVAL_100MS);
+
+    SampleDevice device("dev0");
+    device.Start();
+
+    Scheduler_Reset();
+
+    /* Run super loop */
+    while (true)
+    {
+        Scheduler_UpdateTick();
+        Scheduler_ExecuteTasksReadyToRun();
+        Utils_SleepNanoSec(Scheduler_GetDynamicSleep());
+    }
+
+    return 0;
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
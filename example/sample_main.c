@@ -88,7 +88,7 @@ int main(int argc, char** argv)
     Scheduler_Reset();
 
     /* Example usage: Start a single-shot timer that expires after 5000ms */
-    TaskTimer_t exampleTimer;
+    TaskTimer_t exampleTimer = TASK_TIMER_INIT;
     TaskTimer_Start(&exampleTimer, 5000, ExampleTimerCallback, "USER DATA");
 
     DPRINT("~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~");
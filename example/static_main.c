@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * @file    static_main.c
+ * @author  Kshitij Mistry
+ * @brief   Sample main function for compile time configured scheduler.
+ *
+ * This file contains the main function for a sample application that demonstrates
+ * the usage of the static scheduler. Task set and task periods are declared at compile
+ * time, from which the tick handling and dispatch code is generated.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+/** Smallest timer tick used to schedule tasks in millisec */
+#define STATIC_SCHEDULER_RESOLUTION_MS  (10)
+
+/** Task table of application: TASK(function, period in millisec) */
+#define STATIC_SCHEDULER_TASKS(TASK)    \
+    TASK(SampleFastTask,    20)         \
+    TASK(SampleSlowTask,    1000)
+
+#include "staticScheduler.h"
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+
+/** Daemon super loop run status */
+static cBool gRunSuperLoopF = c_TRUE;
+
+/** Number of times fast task was executed */
+static cU32_t gFastTaskRunCnt = 0;
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+/**
+ * @brief Task which runs every 20 millisec
+ */
+void SampleFastTask(void)
+{
+    gFastTaskRunCnt++;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Task which runs every second
+ */
+void SampleSlowTask(void)
+{
+    IPRINT("fast task executed [%u] times in last second", gFastTaskRunCnt);
+    gFastTaskRunCnt = 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This is main function of static scheduler example
+ * @return 0 if successfully exited else -1 on error occurs
+ */
+int main(void)
+{
+    /* Reset the Timer to measure the correct time from now */
+    StaticScheduler_Reset();
+
+    /* Run super loop */
+    while (gRunSuperLoopF)
+    {
+        /* Read the RTC continuously */
+        StaticScheduler_UpdateTick();
+
+        /* Execute the Queued Tasks */
+        StaticScheduler_ExecuteTasksReadyToRun();
+
+        /* Dynamic Sleep that can be min 10 ms */
+        Utils_SleepNanoSec(StaticScheduler_GetDynamicSleep());
+    }
+
+    return 0;
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,329 @@
+/*****************************************************************************
+ * @file    asyncExecutor.c
+ * @author  Kshitij Mistry
+ * @brief   Bounded background executor implementation file.
+ *
+ * This file implements executor threads which take bodies from pending ring and put them on done
+ * ring once run. Both rings are protected by one mutex which is held only for ring updates, never
+ * while a body runs. Done ring going non-empty is signalled on an eventfd, so a loop waiting for
+ * fd readiness wakes up to collect completions. Executor is started and stopped from loop thread.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "asyncExecutor.h"
+#include "common_clock.h"
+#include "common_def.h"
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Executor threads */
+static pthread_t gExecutorThreads[ASYNC_EXECUTOR_THREADS_MAX];
+
+/** Number of running executor threads */
+static cU8_t gExecutorCnt = 0;
+
+/** Protects all executor state below */
+static pthread_mutex_t gExecutorMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Signalled when body is submitted or executor is stopped */
+static pthread_cond_t gPendingCond = PTHREAD_COND_INITIALIZER;
+
+/** Bodies waiting for executor thread */
+static AsyncExecutorJob_t gPendingJobs[ASYNC_EXECUTOR_QUEUE_MAX];
+
+/** Oldest pending body */
+static cU32_t gPendingHead = 0;
+
+/** Number of pending bodies */
+static cU32_t gPendingCnt = 0;
+
+/** Bodies which have run and wait for loop thread */
+static AsyncExecutorJob_t gDoneJobs[ASYNC_EXECUTOR_QUEUE_MAX];
+
+/** Oldest done body */
+static cU32_t gDoneHead = 0;
+
+/** Number of done bodies, read without lock by poll fast path */
+static cU32_t gDoneCnt = 0;
+
+/** Number of bodies submitted and not yet collected */
+static cU32_t gOutstandingCnt = 0;
+
+/** Executor threads should exit once pending bodies have run */
+static cBool gStopF = c_FALSE;
+
+/** Readable while done ring is not empty, -1 when not created */
+static cI32_t gNotifyFd = -1;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static void *executorThread(void *arg);
+
+static void signalNotifyFd(void);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Start executor threads
+ * @param threadCnt - Number of executor threads
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e AsyncExecutor_Start(cU8_t threadCnt)
+{
+    cU8_t threadId;
+
+    if ((0 == threadCnt) || (threadCnt > ASYNC_EXECUTOR_THREADS_MAX))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (0 != gExecutorCnt)
+    {
+        return (cStatus_RESOURCE_BUSY);
+    }
+
+    gNotifyFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (gNotifyFd < 0)
+    {
+        EPRINT("fail to create executor notify fd");
+        return (cStatus_NO_RESOURCE);
+    }
+
+    gStopF = c_FALSE;
+
+    for (threadId = 0; threadId < threadCnt; threadId++)
+    {
+        if (0 != pthread_create(&gExecutorThreads[threadId], NULL, executorThread, NULL))
+        {
+            EPRINT("fail to create executor thread: [id=%d]", threadId);
+            break;
+        }
+
+        gExecutorCnt++;
+    }
+
+    if (gExecutorCnt != threadCnt)
+    {
+        AsyncExecutor_Stop();
+        return (cStatus_NO_RESOURCE);
+    }
+
+    /* Bodies which completed before restart are not collected yet */
+    MUTEX_LOCK(gExecutorMutex);
+    if (0 != gDoneCnt)
+    {
+        signalNotifyFd();
+    }
+    MUTEX_UNLOCK(gExecutorMutex);
+
+    DPRINT("async executor started: [threads=%d]", gExecutorCnt);
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Stop executor, blocks till all submitted bodies have run
+ * @note Completions of those bodies stay available to AsyncExecutor_PollCompleted
+ */
+void AsyncExecutor_Stop(void)
+{
+    cU8_t threadId;
+
+    MUTEX_LOCK(gExecutorMutex);
+    gStopF = c_TRUE;
+    pthread_cond_broadcast(&gPendingCond);
+    MUTEX_UNLOCK(gExecutorMutex);
+
+    for (threadId = 0; threadId < gExecutorCnt; threadId++)
+    {
+        pthread_join(gExecutorThreads[threadId], NULL);
+    }
+
+    gExecutorCnt = 0;
+
+    if (gNotifyFd >= 0)
+    {
+        close(gNotifyFd);
+        gNotifyFd = -1;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get number of running executor threads
+ * @return Number of executor threads
+ */
+cU8_t AsyncExecutor_GetThreadCount(void)
+{
+    return (gExecutorCnt);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get file descriptor which gets readable when completed bodies are waiting
+ * @return File descriptor, -1 when executor is not started
+ */
+cI32_t AsyncExecutor_GetNotifyFd(void)
+{
+    return (gNotifyFd);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Queue body to run on executor thread
+ * @param (*body) - Body function
+ * @param (*completion) - Completion function returned along with body, may be NULL
+ * @param ctx - Application context
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e AsyncExecutor_Submit(void (*body)(void *ctx), void (*completion)(void *ctx), void *ctx)
+{
+    AsyncExecutorJob_t *pJob;
+
+    if (NULL == body)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (0 == gExecutorCnt)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    MUTEX_LOCK(gExecutorMutex);
+
+    if (gOutstandingCnt >= ASYNC_EXECUTOR_QUEUE_MAX)
+    {
+        MUTEX_UNLOCK(gExecutorMutex);
+        return (cStatus_NO_RESOURCE);
+    }
+
+    pJob = &gPendingJobs[(gPendingHead + gPendingCnt) % ASYNC_EXECUTOR_QUEUE_MAX];
+    pJob->body = body;
+    pJob->completion = completion;
+    pJob->ctx = ctx;
+    pJob->runNs = 0;
+    gPendingCnt++;
+    gOutstandingCnt++;
+
+    pthread_cond_signal(&gPendingCond);
+    MUTEX_UNLOCK(gExecutorMutex);
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Collect bodies which have run, in order of completion
+ * @param pJobs - Array to which completed bodies will get copied
+ * @param maxCnt - Size of array
+ * @return Number of completed bodies copied
+ */
+cU32_t AsyncExecutor_PollCompleted(AsyncExecutorJob_t *pJobs, cU32_t maxCnt)
+{
+    cU32_t jobCnt = 0;
+    eventfd_t value;
+
+    /* Nothing to collect on most iterations, avoid the lock */
+    if ((NULL == pJobs) || (0 == __atomic_load_n(&gDoneCnt, __ATOMIC_ACQUIRE)))
+    {
+        return (0);
+    }
+
+    MUTEX_LOCK(gExecutorMutex);
+
+    while ((jobCnt < maxCnt) && (0 != gDoneCnt))
+    {
+        pJobs[jobCnt++] = gDoneJobs[gDoneHead];
+        gDoneHead = (gDoneHead + 1) % ASYNC_EXECUTOR_QUEUE_MAX;
+        __atomic_store_n(&gDoneCnt, gDoneCnt - 1, __ATOMIC_RELAXED);
+        gOutstandingCnt--;
+    }
+
+    if ((0 == gDoneCnt) && (gNotifyFd >= 0))
+    {
+        (void)eventfd_read(gNotifyFd, &value);
+    }
+
+    MUTEX_UNLOCK(gExecutorMutex);
+
+    return (jobCnt);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Executor thread runs pending bodies and moves them to done ring
+ * @param arg - Not used
+ * @return NULL
+ */
+static void *executorThread(void *arg)
+{
+    AsyncExecutorJob_t job;
+    cU64_t startTimeNs;
+
+    (void)arg;
+
+    MUTEX_LOCK(gExecutorMutex);
+
+    while (1)
+    {
+        while ((c_FALSE == gStopF) && (0 == gPendingCnt))
+        {
+            pthread_cond_wait(&gPendingCond, &gExecutorMutex);
+        }
+
+        /* Stop is requested and nothing is left to run */
+        if (0 == gPendingCnt)
+        {
+            break;
+        }
+
+        job = gPendingJobs[gPendingHead];
+        gPendingHead = (gPendingHead + 1) % ASYNC_EXECUTOR_QUEUE_MAX;
+        gPendingCnt--;
+        MUTEX_UNLOCK(gExecutorMutex);
+
+        startTimeNs = Clock_ReadNanoSec();
+        (*job.body)(job.ctx);
+        job.runNs = Clock_ReadNanoSec() - startTimeNs;
+
+        MUTEX_LOCK(gExecutorMutex);
+
+        /* Outstanding bodies are bounded by ring size, so done ring never overflows */
+        gDoneJobs[(gDoneHead + gDoneCnt) % ASYNC_EXECUTOR_QUEUE_MAX] = job;
+        __atomic_store_n(&gDoneCnt, gDoneCnt + 1, __ATOMIC_RELEASE);
+        if (1 == gDoneCnt)
+        {
+            signalNotifyFd();
+        }
+    }
+
+    MUTEX_UNLOCK(gExecutorMutex);
+    return (NULL);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Make notify fd readable, called with executor mutex held
+ */
+static void signalNotifyFd(void)
+{
+    if (gNotifyFd >= 0)
+    {
+        (void)eventfd_write(gNotifyFd, 1);
+    }
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * @file    asyncExecutor.h
+ * @author  Kshitij Mistry
+ * @brief   Bounded background executor header file.
+ *
+ * This header file defines executor used by scheduler for async tasks. Bodies submitted from the
+ * loop thread run on background threads, and finished bodies are collected back by the loop thread
+ * with AsyncExecutor_PollCompleted, which never blocks on a running body. Number of outstanding
+ * bodies (queued, running or not yet collected) is bounded by ASYNC_EXECUTOR_QUEUE_MAX.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Maximum number of executor threads */
+#define ASYNC_EXECUTOR_THREADS_MAX  (4)
+
+/** Maximum number of outstanding bodies */
+#define ASYNC_EXECUTOR_QUEUE_MAX    (16)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Body submitted to executor, returned back once it has run
+ */
+typedef struct
+{
+    /** Body which runs on executor thread */
+    void (*body)(void *ctx);
+
+    /** Completion to be run by loop thread, executor does not call it */
+    void (*completion)(void *ctx);
+
+    /** Application context */
+    void *ctx;
+
+    /** Run time of body in nanosec, valid once completed */
+    cU64_t runNs;
+
+}AsyncExecutorJob_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e AsyncExecutor_Start(cU8_t threadCnt);
+
+void AsyncExecutor_Stop(void);
+
+cU8_t AsyncExecutor_GetThreadCount(void);
+
+cI32_t AsyncExecutor_GetNotifyFd(void);
+
+cStatus_e AsyncExecutor_Submit(void (*body)(void *ctx), void (*completion)(void *ctx), void *ctx);
+
+cU32_t AsyncExecutor_PollCompleted(AsyncExecutorJob_t *pJobs, cU32_t maxCnt);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,496 @@
+/*****************************************************************************
+ * @file    common_clock.c
+ * @author  Kshitij Mistry
+ * @brief   Fast clock source and per loop iteration time snapshot implementation file.
+ *
+ * This file implements the clock layer. TSC is used only when CPU reports invariant TSC (constant
+ * rate in all P/C states). Cycles are converted to nanoseconds with 32.32 fixed point multiplier
+ * which is calibrated at init and refined on every resync against CLOCK_MONOTONIC, using the
+ * whole span since init. On resync TSC time is never stepped back, the remaining error is slewed
+ * out over next resync interval instead.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_def.h"
+#include "common_clock.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define CLOCK_TSC_SUPPORTED
+#endif
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Nano seconds in 1 sec */
+#define NANO_SECONDS_PER_SECOND     (1000000000LL)
+
+/** Time spent in initial TSC calibration */
+#define CLOCK_CALIBRATION_NS        (2000000ULL)
+
+/** Interval of TSC resync and wall clock offset refresh */
+#define CLOCK_RESYNC_NS             (100000000ULL)
+
+/** TSC time which differs from CLOCK_MONOTONIC more than this is stepped instead of slewed */
+#define CLOCK_STEP_THRESHOLD_NS     (1000000LL)
+
+/** Fraction bits of cycles to nanosec multiplier */
+#define TSC_MULT_SHIFT              (32)
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Clock layer is initialized */
+static cBool gClockInitF = c_FALSE;
+
+/** Source of fresh time reads */
+static ClockSource_e gClockSource = CLOCK_SOURCE_MONOTONIC;
+
+/** CPU has invariant TSC */
+static cBool gTscAvailableF = c_FALSE;
+
+/** Sequence lock of TSC conversion parameters, odd while those are being updated */
+static cU32_t gTscSequence = 0;
+
+/** TSC value at last resync */
+static cU64_t gTscAnchorCycles = 0;
+
+/** Nanosec corresponding to gTscAnchorCycles */
+static cU64_t gTscAnchorNs = 0;
+
+/** Nanosec per cycle in 32.32 fixed point */
+static cU64_t gTscMult = 0;
+
+/** Cycles after which TSC is resynced */
+static cU64_t gTscResyncCycles = 0;
+
+/** Only one thread resyncs TSC at a time */
+static cU32_t gTscResyncLock = 0;
+
+/** TSC value at calibration start */
+static cU64_t gTscBaseCycles = 0;
+
+/** CLOCK_MONOTONIC at calibration start */
+static cU64_t gTscBaseNs = 0;
+
+/** Time snapshot of current loop iteration */
+static cU64_t gSnapshotNs = 0;
+
+/** CLOCK_REALTIME minus CLOCK_MONOTONIC */
+static cI64_t gRealTimeOffsetNs = 0;
+
+/** Snapshot at which gRealTimeOffsetNs was refreshed */
+static cU64_t gRealTimeOffsetRefreshNs = 0;
+
+/** Current time of virtual clock */
+static cU64_t gVirtualTimeNs = 0;
+
+/** Second of broken down local time cached by the thread */
+static __thread time_t tLocalTimeSec = (time_t)-1;
+
+/** Broken down local time cached by the thread */
+static __thread struct tm tLocalTime;
+
+/** Second of broken down time cached for log lines of this thread */
+static __thread time_t tLogTimeSec = (time_t)-1;
+
+/** Broken down time cached for log lines of this thread */
+static __thread struct tm tLogTime;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static cU64_t readMonotonicNs(void);
+
+static void refreshRealTimeOffset(cU64_t monotonicNs);
+
+#ifdef CLOCK_TSC_SUPPORTED
+static cBool isInvariantTscAvailable(void);
+
+static void calibrateTsc(void);
+
+static cU64_t tscToNs(cU64_t cycles);
+
+static void resyncTsc(void);
+#endif
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Detect and calibrate clock sources, TSC is selected when it is usable
+ * @note It is called by Scheduler_Init, other functions initialize clock layer on first use
+ */
+void Clock_Init(void)
+{
+    if (c_TRUE == gClockInitF)
+    {
+        return;
+    }
+
+    gClockInitF = c_TRUE;
+    refreshRealTimeOffset(readMonotonicNs());
+
+#ifdef CLOCK_TSC_SUPPORTED
+    gTscAvailableF = isInvariantTscAvailable();
+    if (c_TRUE == gTscAvailableF)
+    {
+        calibrateTsc();
+        gClockSource = CLOCK_SOURCE_TSC;
+    }
+#endif
+
+    DPRINT("clock source: [%s]", (CLOCK_SOURCE_TSC == gClockSource) ? "tsc" : "monotonic");
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Select source of fresh time reads
+ * @param source - Clock source
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Clock_SetSource(ClockSource_e source)
+{
+    Clock_Init();
+
+    if ((CLOCK_SOURCE_MONOTONIC != source) && (CLOCK_SOURCE_TSC != source) && (CLOCK_SOURCE_VIRTUAL != source))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if ((CLOCK_SOURCE_TSC == source) && (c_FALSE == gTscAvailableF))
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    gClockSource = source;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get source of fresh time reads
+ * @return Clock source
+ */
+ClockSource_e Clock_GetSource(void)
+{
+    Clock_Init();
+
+    return (gClockSource);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Read current time from selected clock source
+ * @return Time in nanosec in CLOCK_MONOTONIC timeline
+ */
+cU64_t Clock_ReadNanoSec(void)
+{
+    if (c_FALSE == gClockInitF)
+    {
+        Clock_Init();
+    }
+
+    if (CLOCK_SOURCE_VIRTUAL == gClockSource)
+    {
+        return (gVirtualTimeNs);
+    }
+
+#ifdef CLOCK_TSC_SUPPORTED
+    if (CLOCK_SOURCE_TSC == gClockSource)
+    {
+        cU64_t cycles = __rdtsc();
+
+        if ((cycles - __atomic_load_n(&gTscAnchorCycles, __ATOMIC_RELAXED)) >= gTscResyncCycles)
+        {
+            resyncTsc();
+        }
+
+        return (tscToNs(cycles));
+    }
+#endif
+
+    return (readMonotonicNs());
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Take time snapshot of current loop iteration, it must be called from loop thread
+ * @return Snapshot time in nanosec, never smaller than previous snapshot
+ */
+cU64_t Clock_Snapshot(void)
+{
+    cU64_t curTimeNs = Clock_ReadNanoSec();
+
+    if (curTimeNs > gSnapshotNs)
+    {
+        __atomic_store_n(&gSnapshotNs, curTimeNs, __ATOMIC_RELAXED);
+    }
+
+    if ((CLOCK_SOURCE_VIRTUAL != gClockSource) && ((gSnapshotNs - gRealTimeOffsetRefreshNs) >= CLOCK_RESYNC_NS))
+    {
+        refreshRealTimeOffset(gSnapshotNs);
+    }
+
+    return (gSnapshotNs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get time snapshot of current loop iteration
+ * @return Snapshot time in nanosec, fresh time if no snapshot is taken yet
+ */
+cU64_t Clock_NowNanoSec(void)
+{
+    cU64_t snapshotNs = __atomic_load_n(&gSnapshotNs, __ATOMIC_RELAXED);
+
+    return (0 != snapshotNs) ? snapshotNs : Clock_ReadNanoSec();
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get wall clock time of current loop iteration
+ * @return Time since epoch in nanosec
+ */
+cU64_t Clock_GetRealTimeNanoSec(void)
+{
+    return (cU64_t)((cI64_t)Clock_NowNanoSec() + __atomic_load_n(&gRealTimeOffsetNs, __ATOMIC_RELAXED));
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get broken down local time of current loop iteration
+ * @param pTime - Structure to which broken time will get copied
+ * @note localtime_r is called only once per second per thread
+ */
+void Clock_GetLocalTime(struct tm *pTime)
+{
+    time_t curSec;
+
+    curSec = (time_t)(Clock_GetRealTimeNanoSec() / NANO_SECONDS_PER_SECOND);
+
+    if (curSec != tLocalTimeSec)
+    {
+        localtime_r(&curSec, &tLocalTime);
+        tLocalTimeSec = curSec;
+    }
+
+    *pTime = tLocalTime;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get broken down local time for log line, read fresh from wall clock
+ * @param pTime - Structure to which broken time will get copied
+ * @note Loop iteration snapshot is not used, so lines of other threads and of a hung loop get current
+ *       time. localtime_r is called only once per second per thread
+ */
+void Clock_GetLogTime(struct tm *pTime)
+{
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_REALTIME, &curTime);
+
+    if (curTime.tv_sec != tLogTimeSec)
+    {
+        localtime_r(&curTime.tv_sec, &tLogTime);
+        tLogTimeSec = curTime.tv_sec;
+    }
+
+    *pTime = tLogTime;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Set time of virtual clock, it is used with CLOCK_SOURCE_VIRTUAL
+ * @param monotonicNs - Virtual monotonic time in nanosec
+ * @param realTimeNs - Wall clock time corresponding to monotonicNs in nanosec since epoch
+ * @note Snapshot is moved to given time as well, even when it is earlier than current snapshot
+ */
+void Clock_SetVirtualTime(cU64_t monotonicNs, cU64_t realTimeNs)
+{
+    gVirtualTimeNs = monotonicNs;
+    __atomic_store_n(&gSnapshotNs, monotonicNs, __ATOMIC_RELAXED);
+    __atomic_store_n(&gRealTimeOffsetNs, (cI64_t)(realTimeNs - monotonicNs), __ATOMIC_RELAXED);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Move virtual clock forward, e.g. by simulated task run time or sleep
+ * @param ns - Nanosec to advance
+ */
+void Clock_AdvanceVirtualTime(cU64_t ns)
+{
+    gVirtualTimeNs += ns;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Read CLOCK_MONOTONIC
+ * @return Time in nanosec
+ */
+static cU64_t readMonotonicNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (cU64_t)((((cU64_t)ts.tv_sec) * NANO_SECONDS_PER_SECOND) + ts.tv_nsec);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Refresh offset between wall clock and monotonic timeline
+ * @param monotonicNs - Time at which offset is refreshed
+ */
+static void refreshRealTimeOffset(cU64_t monotonicNs)
+{
+    struct timespec realTs;
+    struct timespec monoTs;
+
+    clock_gettime(CLOCK_REALTIME, &realTs);
+    clock_gettime(CLOCK_MONOTONIC, &monoTs);
+
+    __atomic_store_n(&gRealTimeOffsetNs, (cI64_t)((realTs.tv_sec - monoTs.tv_sec) * NANO_SECONDS_PER_SECOND)
+                     + (realTs.tv_nsec - monoTs.tv_nsec), __ATOMIC_RELAXED);
+    gRealTimeOffsetRefreshNs = monotonicNs;
+}
+
+#ifdef CLOCK_TSC_SUPPORTED
+//----------------------------------------------------------------------------
+/**
+ * @brief Check CPUID for invariant TSC
+ * @return true if TSC runs at constant rate in all power states
+ */
+static cBool isInvariantTscAvailable(void)
+{
+    cU32_t eax, ebx, ecx, edx;
+
+    if (0 == __get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx))
+    {
+        return (c_FALSE);
+    }
+
+    if (eax < 0x80000007)
+    {
+        return (c_FALSE);
+    }
+
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+
+    return (0 != (edx & (1U << 8))) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Measure TSC rate against CLOCK_MONOTONIC
+ */
+static void calibrateTsc(void)
+{
+    cU64_t curNs;
+    cU64_t curCycles;
+
+    gTscBaseNs = readMonotonicNs();
+    gTscBaseCycles = __rdtsc();
+
+    do
+    {
+        curNs = readMonotonicNs();
+        curCycles = __rdtsc();
+    } while ((curNs - gTscBaseNs) < CLOCK_CALIBRATION_NS);
+
+    gTscMult = (cU64_t)((((unsigned __int128)(curNs - gTscBaseNs)) << TSC_MULT_SHIFT) / (curCycles - gTscBaseCycles));
+    gTscResyncCycles = (cU64_t)((((unsigned __int128)CLOCK_RESYNC_NS) << TSC_MULT_SHIFT) / gTscMult);
+    gTscAnchorNs = curNs;
+    gTscAnchorCycles = curCycles;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Convert TSC value to nanosec
+ * @param cycles - TSC value
+ * @return Time in nanosec in CLOCK_MONOTONIC timeline
+ */
+static cU64_t tscToNs(cU64_t cycles)
+{
+    cU32_t sequence;
+    cU64_t anchorCycles;
+    cU64_t anchorNs;
+    cU64_t mult;
+
+    do
+    {
+        sequence = __atomic_load_n(&gTscSequence, __ATOMIC_ACQUIRE);
+        anchorCycles = gTscAnchorCycles;
+        anchorNs = gTscAnchorNs;
+        mult = gTscMult;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((sequence & 1) || (sequence != __atomic_load_n(&gTscSequence, __ATOMIC_RELAXED)));
+
+    /* Cycles read by other thread just before resync can be older than anchor */
+    if (cycles < anchorCycles)
+    {
+        return anchorNs - (cU64_t)(((unsigned __int128)(anchorCycles - cycles) * mult) >> TSC_MULT_SHIFT);
+    }
+
+    return anchorNs + (cU64_t)(((unsigned __int128)(cycles - anchorCycles) * mult) >> TSC_MULT_SHIFT);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Re-anchor TSC to CLOCK_MONOTONIC and refine its rate
+ */
+static void resyncTsc(void)
+{
+    cU64_t curNs;
+    cU64_t curCycles;
+    cU64_t predictedNs;
+    cU64_t anchorNs;
+    cU64_t mult;
+    cI64_t errorNs;
+
+    if (0 != __atomic_exchange_n(&gTscResyncLock, 1, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+
+    curNs = readMonotonicNs();
+    curCycles = __rdtsc();
+    predictedNs = tscToNs(curCycles);
+    errorNs = (cI64_t)(curNs - predictedNs);
+
+    /* Rate is measured over whole span since calibration, so it gets more accurate over time */
+    mult = (cU64_t)((((unsigned __int128)(curNs - gTscBaseNs)) << TSC_MULT_SHIFT) / (curCycles - gTscBaseCycles));
+
+    if ((errorNs >= 0) || (errorNs < -CLOCK_STEP_THRESHOLD_NS))
+    {
+        /* TSC time behind (or far off) is stepped to CLOCK_MONOTONIC */
+        anchorNs = curNs;
+    }
+    else
+    {
+        /* TSC time ahead is not stepped back, it runs slower till next resync instead */
+        anchorNs = predictedNs;
+        mult = (cU64_t)(((unsigned __int128)mult * (cU64_t)((cI64_t)CLOCK_RESYNC_NS + errorNs)) / CLOCK_RESYNC_NS);
+    }
+
+    __atomic_store_n(&gTscSequence, gTscSequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    gTscMult = mult;
+    gTscAnchorNs = anchorNs;
+    __atomic_store_n(&gTscAnchorCycles, curCycles, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&gTscSequence, gTscSequence + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&gTscResyncLock, 0, __ATOMIC_RELEASE);
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
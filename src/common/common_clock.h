@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * @file    common_clock.h
+ * @author  Kshitij Mistry
+ * @brief   Fast clock source and per loop iteration time snapshot header file.
+ *
+ * This header file declares the clock layer used by scheduler, TaskTimer and logging. Super loop
+ * takes one snapshot of time per iteration (Clock_Snapshot) and every consumer of "now" in that
+ * iteration reads the snapshot instead of calling clock_gettime again. Fresh reads (task run time,
+ * sleep calculation) use a calibrated TSC on x86 machines with invariant TSC, otherwise
+ * CLOCK_MONOTONIC. Both sources give nanoseconds in CLOCK_MONOTONIC timeline.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include <time.h>
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * ENUMS
+ *****************************************************************************/
+/**
+ * @brief   Source of fresh time reads
+ */
+typedef enum
+{
+    /** clock_gettime(CLOCK_MONOTONIC) */
+    CLOCK_SOURCE_MONOTONIC = 0,
+
+    /** rdtsc calibrated against and periodically resynced to CLOCK_MONOTONIC */
+    CLOCK_SOURCE_TSC,
+
+    /** Virtual time which moves only by Clock_AdvanceVirtualTime (replay and simulation) */
+    CLOCK_SOURCE_VIRTUAL,
+
+}ClockSource_e;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+void Clock_Init(void);
+
+cStatus_e Clock_SetSource(ClockSource_e source);
+
+ClockSource_e Clock_GetSource(void);
+
+cU64_t Clock_ReadNanoSec(void);
+
+cU64_t Clock_Snapshot(void);
+
+cU64_t Clock_NowNanoSec(void);
+
+cU64_t Clock_GetRealTimeNanoSec(void);
+
+void Clock_GetLocalTime(struct tm *pTime);
+
+void Clock_GetLogTime(struct tm *pTime);
+
+void Clock_SetVirtualTime(cU64_t monotonicNs, cU64_t realTimeNs);
+
+void Clock_AdvanceVirtualTime(cU64_t ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -8,12 +8,17 @@
  *****************************************************************************/
 #pragma once
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*****************************************************************************
  * INCLUDES
  *****************************************************************************/
 #include <stdio.h>
 #include <time.h>
 #include "common_stddef.h"
+#include "common_clock.h"
 
 /*****************************************************************************
  * MACROS
@@ -28,9 +33,8 @@
 // Internal macro for printing with color
 #define __PRINT_WITH_COLOR(color, fmt, ...)                                 \
     do {                                                                    \
-        time_t __t = time(NULL);                                            \
         struct tm __tm;                                                     \
-        localtime_r(&__t, &__tm);                                           \
+        Clock_GetLogTime(&__tm);                                            \
         fprintf(stderr, "%s%02d:%02d:%02d : %s[%d] : " fmt "%s\n",          \
                 color,                                                      \
                 __tm.tm_hour, __tm.tm_min, __tm.tm_sec,                     \
@@ -70,6 +74,10 @@
  *****************************************************************************/
 const cChar* EnumToStr_cStatus_e(cStatus_e cStatus);
 
+#ifdef __cplusplus
+}
+#endif
+
 /*****************************************************************************
  * @END OF FILE
  *****************************************************************************/
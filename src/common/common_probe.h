@@ -0,0 +1,50 @@
+/*****************************************************************************
+ * @file    common_probe.h
+ * @author  Kshitij Mistry
+ * @brief   Static tracepoint header file.
+ *
+ * This header file defines USDT probes of provider "scheduler". When built with SCHEDULER_USDT_ENABLED
+ * (set by build when sys/sdt.h is found), each probe is a single nop in the code plus a note in ELF which
+ * tracers like bpftrace, perf or systemtap patch at attach time. Otherwise probes expand to nothing.
+ * Arguments should be values already at hand, they are evaluated even when nobody is attached.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#if defined(SCHEDULER_USDT_ENABLED)
+#include <sys/sdt.h>
+#endif
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+#if defined(SCHEDULER_USDT_ENABLED)
+
+#define SCHEDULER_PROBE1(name, a1)                  DTRACE_PROBE1(scheduler, name, a1)
+#define SCHEDULER_PROBE2(name, a1, a2)              DTRACE_PROBE2(scheduler, name, a1, a2)
+#define SCHEDULER_PROBE3(name, a1, a2, a3)          DTRACE_PROBE3(scheduler, name, a1, a2, a3)
+#define SCHEDULER_PROBE4(name, a1, a2, a3, a4)      DTRACE_PROBE4(scheduler, name, a1, a2, a3, a4)
+
+#else
+
+#define SCHEDULER_PROBE1(name, a1)                  do { } while (0)
+#define SCHEDULER_PROBE2(name, a1, a2)              do { } while (0)
+#define SCHEDULER_PROBE3(name, a1, a2, a3)          do { } while (0)
+#define SCHEDULER_PROBE4(name, a1, a2, a3, a4)      do { } while (0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -13,7 +13,9 @@
 /*****************************************************************************
  * INCLUDES
  *****************************************************************************/
+#include "common_probe.h"
 #include "common_utils.h"
+#include "common_wait.h"
 #include <errno.h>
 
 /*****************************************************************************
@@ -34,6 +36,17 @@ void Utils_SleepNanoSec(cU64_t ns)
 {
     struct timespec req = {0, 0};
 
+    /* Precision wait sleeps till just before deadline and busy waits for the rest */
+    if (c_TRUE == Wait_IsPrecisionEnabled())
+    {
+        SCHEDULER_PROBE2(sleep__enter, ns, 1);
+        Wait_NanoSec(ns);
+        SCHEDULER_PROBE1(sleep__exit, ns);
+        return;
+    }
+
+    SCHEDULER_PROBE2(sleep__enter, ns, 0);
+
     if (ns >= NANO_SECONDS_PER_SECOND)
     {
         req.tv_sec = (ns / NANO_SECONDS_PER_SECOND);
@@ -49,6 +62,8 @@ void Utils_SleepNanoSec(cU64_t ns)
     {
         continue;
     }
+
+    SCHEDULER_PROBE1(sleep__exit, ns);
 }
 
 //----------------------------------------------------------------------------
@@ -81,6 +96,36 @@ cU64_t Utils_GetMonotonicTimeInSec(void)
     return (cU64_t)(ts.tv_sec);
 }
 
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gets the wall clock time since epoch in nanosec
+ * @return Time since epoch in nanosec
+ */
+cU64_t Utils_GetRealTimeInNanoSec(void)
+{
+    struct timespec ts;
+
+    /* Get time in form of sec & nano sec */
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    return (cU64_t)((((cU64_t)ts.tv_sec) * NANO_SECONDS_PER_SECOND) + ts.tv_nsec);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gets CPU time consumed by calling thread in nanosec
+ * @return Thread CPU time in nanosec
+ */
+cU64_t Utils_GetThreadCpuTimeInNanoSec(void)
+{
+    struct timespec ts;
+
+    /* Get time in form of sec & nano sec */
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+    return (cU64_t)((((cU64_t)ts.tv_sec) * NANO_SECONDS_PER_SECOND) + ts.tv_nsec);
+}
+
 //----------------------------------------------------------------------------
 /**
  * @brief To get current broken time and date of system
@@ -11,6 +11,10 @@
  *****************************************************************************/
 #pragma once
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*****************************************************************************
  * INCLUDES
  *****************************************************************************/
@@ -27,8 +31,16 @@ cU64_t Utils_GetMonotonicTimeInNanoSec(void);
 
 cU64_t Utils_GetMonotonicTimeInSec(void);
 
+cU64_t Utils_GetRealTimeInNanoSec(void);
+
+cU64_t Utils_GetThreadCpuTimeInNanoSec(void);
+
 void Utils_GetTimeSinceEpoch(struct tm *pTime);
 
+#ifdef __cplusplus
+}
+#endif
+
 /*****************************************************************************
  * @END OF FILE
  *****************************************************************************/
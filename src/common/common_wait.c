@@ -0,0 +1,332 @@
+/*****************************************************************************
+ * @file    common_wait.c
+ * @author  Kshitij Mistry
+ * @brief   High precision wait implementation file.
+ *
+ * This file implements hybrid sleep-then-spin wait. Every kernel sleep targets deadline minus guard
+ * (absolute CLOCK_MONOTONIC sleep) and its overshoot is kept in a ring of recent samples. Guard is
+ * refreshed from the configured percentile of that ring, so it follows the host as timer slack or
+ * load changes. Remaining time is burnt with pause instruction, limited by per-wait and per-second
+ * caps. Functions are meant for the super loop thread only.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_wait.h"
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Nano seconds in 1 sec */
+#define NANO_SECONDS_PER_SECOND     (1000000000ULL)
+
+/** Number of recent overshoot samples used for guard */
+#define WAIT_SAMPLES                (64)
+
+/** Guard is recomputed after this many new samples */
+#define WAIT_GUARD_REFRESH          (8)
+
+/** Guard before first samples are available */
+#define WAIT_INITIAL_GUARD_NS       (100000U)
+
+/** Window of busy wait budget */
+#define WAIT_BUDGET_WINDOW_NS       (NANO_SECONDS_PER_SECOND)
+
+#if defined(__x86_64__) || defined(__i386__)
+#define WAIT_CPU_RELAX()            __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define WAIT_CPU_RELAX()            __asm__ __volatile__("yield")
+#else
+#define WAIT_CPU_RELAX()            do {} while (0)
+#endif
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Precision wait is enabled */
+static cBool gPrecisionF = c_FALSE;
+
+/** Precision wait configuration */
+static WaitPrecisionConfig_t gConfig;
+
+/** Recent sleep overshoots in nanosec */
+static cU32_t gSamples[WAIT_SAMPLES];
+
+/** Number of samples taken since reset */
+static cU64_t gSampleCnt = 0;
+
+/** Guard before deadline in nanosec */
+static cU32_t gGuardNs = WAIT_INITIAL_GUARD_NS;
+
+/** Start of current busy wait budget window */
+static cU64_t gBudgetStartNs = 0;
+
+/** Busy wait in current budget window */
+static cU64_t gBudgetSpinNs = 0;
+
+/** Statistics */
+static WaitStats_t gStats;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static void sleepUntil(cU64_t targetNs);
+
+static void addOvershootSample(cU64_t overshootNs);
+
+static cU32_t getOvershootPercentile(cU32_t percentile);
+
+static cU32_t getHistogramBucket(cU64_t ns);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Enable or disable precision wait
+ * @param pConfig - Configuration, NULL to disable
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Wait_SetPrecision(const WaitPrecisionConfig_t *pConfig)
+{
+    if (NULL == pConfig)
+    {
+        gPrecisionF = c_FALSE;
+        return (cStatus_SUCCESS);
+    }
+
+    if ((pConfig->maxSpinPercent > 100) || (pConfig->overshootPercentile < 50) || (pConfig->overshootPercentile > 100))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    Clock_Init();
+
+    gConfig = *pConfig;
+    Wait_ResetStats();
+    gPrecisionF = c_TRUE;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if precision wait is enabled
+ * @return true if enabled
+ */
+cBool Wait_IsPrecisionEnabled(void)
+{
+    return (gPrecisionF);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Wait till deadline, sleep first and busy wait for the guard before deadline
+ * @param deadlineNs - Deadline in CLOCK_MONOTONIC timeline (Clock_ReadNanoSec)
+ * @note Busy wait never exceeds maxSpinNs, returns immediately on virtual clock source
+ */
+void Wait_UntilNanoSec(cU64_t deadlineNs)
+{
+    cU64_t curTimeNs;
+    cU64_t spinStartNs;
+    cU64_t spinNs;
+    cU64_t guardNs = gGuardNs;
+    cU64_t lateNs;
+
+    /* Virtual time does not move while we wait, deadline would never be reached */
+    if (CLOCK_SOURCE_VIRTUAL == Clock_GetSource())
+    {
+        return;
+    }
+
+    curTimeNs = Clock_ReadNanoSec();
+    gStats.waits++;
+
+    /* Busy wait is not allowed once its budget of this window is used up */
+    if ((curTimeNs - gBudgetStartNs) >= WAIT_BUDGET_WINDOW_NS)
+    {
+        gBudgetStartNs = curTimeNs;
+        gBudgetSpinNs = 0;
+    }
+
+    if (gBudgetSpinNs >= ((WAIT_BUDGET_WINDOW_NS / 100) * gConfig.maxSpinPercent))
+    {
+        guardNs = 0;
+        gStats.spinCapped++;
+    }
+    else if (guardNs > gConfig.maxSpinNs)
+    {
+        guardNs = gConfig.maxSpinNs;
+        gStats.spinCapped++;
+    }
+
+    /* Sleep again if we woke up early against clock source, so that spin is bounded by guard */
+    while (deadlineNs > (curTimeNs + guardNs))
+    {
+        sleepUntil(deadlineNs - guardNs);
+        curTimeNs = Clock_ReadNanoSec();
+        addOvershootSample((curTimeNs > (deadlineNs - guardNs)) ? (curTimeNs - (deadlineNs - guardNs)) : 0);
+    }
+
+    /* Burn rest of the time, pause lets sibling hyper-thread run and saves power */
+    spinStartNs = curTimeNs;
+    while (curTimeNs < deadlineNs)
+    {
+        WAIT_CPU_RELAX();
+        curTimeNs = Clock_ReadNanoSec();
+    }
+
+    spinNs = curTimeNs - spinStartNs;
+    gStats.spinNs += spinNs;
+    gBudgetSpinNs += spinNs;
+
+    lateNs = curTimeNs - deadlineNs;
+    gStats.lateHistogram[getHistogramBucket(lateNs)]++;
+    if (lateNs > gStats.maxLateNs)
+    {
+        gStats.maxLateNs = lateNs;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Wait for given time
+ * @param ns - Time to wait in nanosec
+ */
+void Wait_NanoSec(cU64_t ns)
+{
+    Wait_UntilNanoSec(Clock_ReadNanoSec() + ns);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get precision wait statistics
+ * @param pStats - Structure to which statistics will get copied
+ */
+void Wait_GetStats(WaitStats_t *pStats)
+{
+    if (NULL == pStats)
+    {
+        return;
+    }
+
+    *pStats = gStats;
+    pStats->guardNs = gGuardNs;
+    pStats->p50OvershootNs = getOvershootPercentile(50);
+    pStats->p99OvershootNs = getOvershootPercentile(99);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Reset precision wait statistics and calibration
+ */
+void Wait_ResetStats(void)
+{
+    memset(&gStats, 0, sizeof(gStats));
+    gSampleCnt = 0;
+    gGuardNs = WAIT_INITIAL_GUARD_NS;
+    gBudgetStartNs = 0;
+    gBudgetSpinNs = 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Sleep till absolute CLOCK_MONOTONIC time
+ * @param targetNs - Wakeup time in nanosec
+ */
+static void sleepUntil(cU64_t targetNs)
+{
+    struct timespec req;
+
+    req.tv_sec = (time_t)(targetNs / NANO_SECONDS_PER_SECOND);
+    req.tv_nsec = (long)(targetNs % NANO_SECONDS_PER_SECOND);
+
+    /* Absolute sleep is not extended by signals */
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &req, NULL))
+    {
+        continue;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Account overshoot of kernel sleep and refresh guard periodically
+ * @param overshootNs - Time by which sleep ended after its target
+ */
+static void addOvershootSample(cU64_t overshootNs)
+{
+    gSamples[gSampleCnt % WAIT_SAMPLES] = (overshootNs > UINT32_MAX) ? UINT32_MAX : (cU32_t)overshootNs;
+    gSampleCnt++;
+
+    gStats.overshootHistogram[getHistogramBucket(overshootNs)]++;
+    if (overshootNs > gStats.maxOvershootNs)
+    {
+        gStats.maxOvershootNs = overshootNs;
+    }
+
+    if (0 == (gSampleCnt % WAIT_GUARD_REFRESH))
+    {
+        gGuardNs = getOvershootPercentile(gConfig.overshootPercentile);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get percentile of recent sleep overshoots
+ * @param percentile - Percentile (0..100)
+ * @return Overshoot in nanosec, 0 if no sample is taken yet
+ */
+static cU32_t getOvershootPercentile(cU32_t percentile)
+{
+    cU32_t sorted[WAIT_SAMPLES];
+    cU32_t sampleCnt = (gSampleCnt < WAIT_SAMPLES) ? (cU32_t)gSampleCnt : WAIT_SAMPLES;
+    cU32_t idx;
+    cU32_t pos;
+
+    if (0 == sampleCnt)
+    {
+        return (0);
+    }
+
+    /* Insertion sort of recent samples, ring is small */
+    for (idx = 0; idx < sampleCnt; idx++)
+    {
+        for (pos = idx; (pos > 0) && (sorted[pos - 1] > gSamples[idx]); pos--)
+        {
+            sorted[pos] = sorted[pos - 1];
+        }
+
+        sorted[pos] = gSamples[idx];
+    }
+
+    return (sorted[((sampleCnt - 1) * percentile) / 100]);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get histogram bucket of time
+ * @param ns - Time in nanosec
+ * @return Bucket index
+ */
+static cU32_t getHistogramBucket(cU64_t ns)
+{
+    cU64_t us = ns / 1000;
+    cU32_t bucket = 0;
+
+    while ((0 != us) && (bucket < (WAIT_HISTOGRAM_BUCKETS - 1)))
+    {
+        us >>= 1;
+        bucket++;
+    }
+
+    return (bucket);
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * @file    common_wait.h
+ * @author  Kshitij Mistry
+ * @brief   High precision wait header file.
+ *
+ * This header file declares precision wait: sleep until just before the deadline, then busy wait
+ * for the rest. Guard before deadline is derived online from the observed overshoot of kernel
+ * sleeps, and busy waiting is capped per wait and per second. When enabled, Utils_SleepNanoSec
+ * uses it, so super loop sleep gets precise without any change in application.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Buckets of wait histograms, bucket 0 is below 1 us, bucket N is [2^(N-1), 2^N) us, last is open */
+#define WAIT_HISTOGRAM_BUCKETS      (12)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Precision wait configuration
+ */
+typedef struct
+{
+    /** Max busy wait at end of one wait in nanosec */
+    cU32_t maxSpinNs;
+
+    /** Max share of wall time spent in busy wait in percent (per one second), beyond it waits only sleep */
+    cU32_t maxSpinPercent;
+
+    /** Percentile of recent sleep overshoots which is used as guard before deadline (50..100) */
+    cU32_t overshootPercentile;
+
+}WaitPrecisionConfig_t;
+
+/**
+ * @brief   Precision wait statistics
+ */
+typedef struct
+{
+    /** Number of waits */
+    cU64_t waits;
+
+    /** Total busy wait in nanosec */
+    cU64_t spinNs;
+
+    /** Number of waits whose busy wait was cut by per-wait or per-second cap */
+    cU64_t spinCapped;
+
+    /** Current guard before deadline in nanosec */
+    cU32_t guardNs;
+
+    /** Median of recent sleep overshoots in nanosec */
+    cU32_t p50OvershootNs;
+
+    /** 99th percentile of recent sleep overshoots in nanosec */
+    cU32_t p99OvershootNs;
+
+    /** Max sleep overshoot in nanosec */
+    cU64_t maxOvershootNs;
+
+    /** Max lateness of wakeup against deadline in nanosec */
+    cU64_t maxLateNs;
+
+    /** Overshoot of kernel sleep beyond its target */
+    cU64_t overshootHistogram[WAIT_HISTOGRAM_BUCKETS];
+
+    /** Lateness of return against deadline (after busy wait) */
+    cU64_t lateHistogram[WAIT_HISTOGRAM_BUCKETS];
+
+}WaitStats_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e Wait_SetPrecision(const WaitPrecisionConfig_t *pConfig);
+
+cBool Wait_IsPrecisionEnabled(void);
+
+void Wait_UntilNanoSec(cU64_t deadlineNs);
+
+void Wait_NanoSec(cU64_t ns);
+
+void Wait_GetStats(WaitStats_t *pStats);
+
+void Wait_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,447 @@
+/*****************************************************************************
+ * @file    compactTimer.c
+ * @author  Kshitij Mistry
+ * @brief   Compact index based timer implementation file.
+ *
+ * This file implements compact timers. Free nodes are chained through their next index. Running
+ * nodes are doubly linked by index in wheel slot (expiry tick % slots), so start and stop are O(1)
+ * and a tick walks one slot only; nodes of later wheel rounds are skipped by comparing expiry
+ * tick. Like TaskTimer, expiry callbacks may start, stop or free any timer while slot is walked.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_def.h"
+#include "compactTimer.h"
+#include "loopStats.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Callback class shared by timers
+ */
+typedef struct
+{
+    /** Expiry callback, NULL when class is not registered */
+    void (*callback)(void *classCtx, cU32_t timerId, cU32_t tag);
+
+    /** Context passed to callback */
+    void *classCtx;
+
+}CompactTimerClass_t;
+
+_Static_assert(sizeof(CompactTimerNode_t) == 16, "compact timer node must stay 16 bytes");
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Timer nodes */
+static CompactTimerNode_t *gNodes = NULL;
+
+/** Per timer tag, NULL when tags are disabled */
+static cU32_t *gTags = NULL;
+
+/** First node of every wheel slot */
+static cU32_t *gWheel = NULL;
+
+/** Number of nodes */
+static cU32_t gCapacity = 0;
+
+/** Wheel slots - 1 (slots are power of two) */
+static cU32_t gWheelMask = 0;
+
+/** First free node */
+static cU32_t gFreeHead = COMPACT_TIMER_INVALID;
+
+/** Number of allocated timers */
+static cU32_t gAllocatedCnt = 0;
+
+/** Number of running timers */
+static cU32_t gRunningCnt = 0;
+
+/** Current tick */
+static cU32_t gCurTick = 0;
+
+/** Node which tick visits next, COMPACT_TIMER_INVALID when no tick is in progress */
+static cU32_t gNextNode = COMPACT_TIMER_INVALID;
+
+/** Callback classes, class 0 is reserved for free nodes */
+static CompactTimerClass_t gClasses[COMPACT_TIMER_CLASSES_MAX];
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static cBool isAllocated(cU32_t timerId);
+
+static void linkNode(cU32_t timerId);
+
+static void unlinkNode(cU32_t timerId);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Allocate timer nodes and timing wheel
+ * @param capacity - Max number of timers
+ * @param wheelSlots - Number of wheel slots, rounded up to power of two (timers per tick are capacity / slots)
+ * @param withTags - true to keep 32-bit tag per timer
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e CompactTimer_Init(cU32_t capacity, cU32_t wheelSlots, cBool withTags)
+{
+    cU32_t timerId;
+    cU32_t slots = 1;
+
+    if ((0 == capacity) || (COMPACT_TIMER_INVALID == capacity) || (0 == wheelSlots) || (wheelSlots > (1U << 31)))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    CompactTimer_Exit();
+
+    while (slots < wheelSlots)
+    {
+        slots <<= 1;
+    }
+
+    gNodes = (CompactTimerNode_t *)malloc((size_t)capacity * sizeof(CompactTimerNode_t));
+    gWheel = (cU32_t *)malloc((size_t)slots * sizeof(cU32_t));
+    gTags = (c_TRUE == withTags) ? (cU32_t *)calloc(capacity, sizeof(cU32_t)) : NULL;
+
+    if ((NULL == gNodes) || (NULL == gWheel) || ((c_TRUE == withTags) && (NULL == gTags)))
+    {
+        EPRINT("fail to allocate compact timers: [capacity=%u], [slots=%u]", capacity, slots);
+        CompactTimer_Exit();
+        return (cStatus_NO_RESOURCE);
+    }
+
+    for (timerId = 0; timerId < capacity; timerId++)
+    {
+        gNodes[timerId].next = timerId + 1;
+        gNodes[timerId].prev = COMPACT_TIMER_INVALID;
+        gNodes[timerId].expiryTick = 0;
+        gNodes[timerId].classId = 0;
+        gNodes[timerId].running = c_FALSE;
+    }
+
+    gNodes[capacity - 1].next = COMPACT_TIMER_INVALID;
+
+    for (timerId = 0; timerId < slots; timerId++)
+    {
+        gWheel[timerId] = COMPACT_TIMER_INVALID;
+    }
+
+    gCapacity = capacity;
+    gWheelMask = slots - 1;
+    gFreeHead = 0;
+    gAllocatedCnt = 0;
+    gRunningCnt = 0;
+    gCurTick = 0;
+    gNextNode = COMPACT_TIMER_INVALID;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Release timer nodes, timing wheel and callback classes
+ */
+void CompactTimer_Exit(void)
+{
+    free(gNodes);
+    free(gTags);
+    free(gWheel);
+
+    gNodes = NULL;
+    gTags = NULL;
+    gWheel = NULL;
+    gCapacity = 0;
+    gFreeHead = COMPACT_TIMER_INVALID;
+    gAllocatedCnt = 0;
+    gRunningCnt = 0;
+    memset(gClasses, 0, sizeof(gClasses));
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Register expiry callback shared by a class of timers
+ * @param (*callback) - Expiry callback, gets class context, timer index and its tag
+ * @param classCtx - Context passed to callback
+ * @param pClassId - Class id used to allocate timers
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e CompactTimer_RegisterClass(void (*callback)(void *classCtx, cU32_t timerId, cU32_t tag), void *classCtx,
+                                     cU16_t *pClassId)
+{
+    cU16_t classId;
+
+    if ((NULL == callback) || (NULL == pClassId))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    for (classId = 1; classId < COMPACT_TIMER_CLASSES_MAX; classId++)
+    {
+        if (NULL == gClasses[classId].callback)
+        {
+            gClasses[classId].callback = callback;
+            gClasses[classId].classCtx = classCtx;
+            *pClassId = classId;
+            return (cStatus_SUCCESS);
+        }
+    }
+
+    return (cStatus_NO_RESOURCE);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Take timer from free list
+ * @param classId - Callback class of timer
+ * @param tag - Value passed to callback (kept only when tags are enabled)
+ * @param pTimerId - Index of allocated timer
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e CompactTimer_Alloc(cU16_t classId, cU32_t tag, cU32_t *pTimerId)
+{
+    cU32_t timerId = gFreeHead;
+
+    if ((NULL == pTimerId) || (0 == classId) || (classId >= COMPACT_TIMER_CLASSES_MAX) || (NULL == gClasses[classId].callback))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (COMPACT_TIMER_INVALID == timerId)
+    {
+        return (cStatus_NO_RESOURCE);
+    }
+
+    gFreeHead = gNodes[timerId].next;
+    gNodes[timerId].next = COMPACT_TIMER_INVALID;
+    gNodes[timerId].prev = COMPACT_TIMER_INVALID;
+    gNodes[timerId].classId = classId;
+    gNodes[timerId].running = c_FALSE;
+
+    if (NULL != gTags)
+    {
+        gTags[timerId] = tag;
+    }
+
+    gAllocatedCnt++;
+    *pTimerId = timerId;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Stop timer and return it to free list
+ * @param timerId - Timer index
+ */
+void CompactTimer_Free(cU32_t timerId)
+{
+    if (c_FALSE == isAllocated(timerId))
+    {
+        return;
+    }
+
+    CompactTimer_Stop(timerId);
+
+    gNodes[timerId].classId = 0;
+    gNodes[timerId].next = gFreeHead;
+    gFreeHead = timerId;
+    gAllocatedCnt--;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Start or restart single shot timer
+ * @param timerId - Timer index
+ * @param expireAfterMs - Time in millisec after which timer expires (at least one tick)
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e CompactTimer_Start(cU32_t timerId, cU32_t expireAfterMs)
+{
+    cU32_t ticks = (expireAfterMs / COMPACT_TIMER_TICK_RESOLUTION_IN_MS);
+
+    if (c_FALSE == isAllocated(timerId))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    CompactTimer_Stop(timerId);
+
+    gNodes[timerId].expiryTick = gCurTick + ((0 == ticks) ? 1 : ticks);
+    linkNode(timerId);
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Stop timer
+ * @param timerId - Timer index
+ */
+void CompactTimer_Stop(cU32_t timerId)
+{
+    if ((c_TRUE == isAllocated(timerId)) && (c_TRUE == gNodes[timerId].running))
+    {
+        unlinkNode(timerId);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if timer is running
+ * @param timerId - Timer index
+ * @return Returns true if timer is running, false otherwise
+ */
+cBool CompactTimer_IsRunning(cU32_t timerId)
+{
+    return ((c_TRUE == isAllocated(timerId)) && (c_TRUE == gNodes[timerId].running)) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Advance one tick and expire timers of its wheel slot
+ */
+void CompactTimer_Tick(void)
+{
+    cU32_t timerId;
+    CompactTimerClass_t *pClass;
+
+    if (NULL == gNodes)
+    {
+        return;
+    }
+
+    gCurTick++;
+
+    if (0 != (LoopStats_GetEnabled() & LOOP_STATS_PHASES))
+    {
+        LoopStats_PhaseBegin(LOOP_PHASE_TIMER_EXPIRY, Clock_ReadNanoSec());
+    }
+
+    timerId = gWheel[gCurTick & gWheelMask];
+    while (COMPACT_TIMER_INVALID != timerId)
+    {
+        /* Callbacks may stop or free the node which is visited next, then walk continues after it */
+        gNextNode = gNodes[timerId].next;
+
+        if (gNodes[timerId].expiryTick == gCurTick)
+        {
+            unlinkNode(timerId);
+
+            pClass = &gClasses[gNodes[timerId].classId];
+            (*pClass->callback)(pClass->classCtx, timerId, (NULL != gTags) ? gTags[timerId] : 0);
+        }
+
+        timerId = gNextNode;
+    }
+
+    gNextNode = COMPACT_TIMER_INVALID;
+
+    if (0 != (LoopStats_GetEnabled() & LOOP_STATS_PHASES))
+    {
+        LoopStats_PhaseEnd(Clock_ReadNanoSec());
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get memory used by compact timers
+ * @param pFootprint - Structure to which footprint will get copied
+ */
+void CompactTimer_GetFootprint(CompactTimerFootprint_t *pFootprint)
+{
+    if (NULL == pFootprint)
+    {
+        return;
+    }
+
+    pFootprint->capacity = gCapacity;
+    pFootprint->allocated = gAllocatedCnt;
+    pFootprint->running = gRunningCnt;
+    pFootprint->nodeBytes = (cU64_t)gCapacity * sizeof(CompactTimerNode_t);
+    pFootprint->tagBytes = (NULL != gTags) ? ((cU64_t)gCapacity * sizeof(cU32_t)) : 0;
+    pFootprint->wheelBytes = (NULL != gWheel) ? (((cU64_t)gWheelMask + 1) * sizeof(cU32_t)) : 0;
+    pFootprint->classBytes = sizeof(gClasses);
+    pFootprint->totalBytes = pFootprint->nodeBytes + pFootprint->tagBytes + pFootprint->wheelBytes + pFootprint->classBytes;
+    pFootprint->bytesPerTimer = (0 != gCapacity) ? ((cDouble_t)pFootprint->totalBytes / gCapacity) : 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if timer index refers to allocated timer
+ * @param timerId - Timer index
+ * @return true if timer is allocated
+ */
+static cBool isAllocated(cU32_t timerId)
+{
+    return ((timerId < gCapacity) && (0 != gNodes[timerId].classId)) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Link node at head of wheel slot of its expiry tick
+ * @param timerId - Timer index
+ */
+static void linkNode(cU32_t timerId)
+{
+    cU32_t *pHead = &gWheel[gNodes[timerId].expiryTick & gWheelMask];
+
+    gNodes[timerId].prev = COMPACT_TIMER_INVALID;
+    gNodes[timerId].next = *pHead;
+
+    if (COMPACT_TIMER_INVALID != *pHead)
+    {
+        gNodes[*pHead].prev = timerId;
+    }
+
+    *pHead = timerId;
+    gNodes[timerId].running = c_TRUE;
+    gRunningCnt++;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Unlink node from its wheel slot
+ * @param timerId - Timer index
+ */
+static void unlinkNode(cU32_t timerId)
+{
+    CompactTimerNode_t *pNode = &gNodes[timerId];
+
+    /* Tick in progress continues from node after the removed one */
+    if (timerId == gNextNode)
+    {
+        gNextNode = pNode->next;
+    }
+
+    if (COMPACT_TIMER_INVALID != pNode->prev)
+    {
+        gNodes[pNode->prev].next = pNode->next;
+    }
+    else
+    {
+        gWheel[pNode->expiryTick & gWheelMask] = pNode->next;
+    }
+
+    if (COMPACT_TIMER_INVALID != pNode->next)
+    {
+        gNodes[pNode->next].prev = pNode->prev;
+    }
+
+    pNode->next = COMPACT_TIMER_INVALID;
+    pNode->prev = COMPACT_TIMER_INVALID;
+    pNode->running = c_FALSE;
+    gRunningCnt--;
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * @file    compactTimer.h
+ * @author  Kshitij Mistry
+ * @brief   Compact index based timer header file.
+ *
+ * This header file defines compact timers for very large timer populations. Timers live in one
+ * preallocated array and are identified by 32-bit index instead of pointer. A node holds only its
+ * links, packed expiry tick and callback class (16 bytes). Callback and its context are shared
+ * per class, per-timer user value is an optional 32-bit tag kept in a side table. Running timers
+ * are hashed on a timing wheel by expiry tick, so a tick visits only timers of its own slot.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Timer tick in milliseconds, CompactTimer_Tick is registered with TIME_INTERVAL_100MS */
+#define COMPACT_TIMER_TICK_RESOLUTION_IN_MS (100)
+
+/** Invalid timer index */
+#define COMPACT_TIMER_INVALID       (UINT32_MAX)
+
+/** Maximum number of callback classes */
+#define COMPACT_TIMER_CLASSES_MAX   (64)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Compact timer node
+ */
+typedef struct
+{
+    /** Next node in wheel slot or in free list */
+    cU32_t next;
+
+    /** Previous node in wheel slot, COMPACT_TIMER_INVALID for first node */
+    cU32_t prev;
+
+    /** Absolute expiry tick, compared modulo 2^32 */
+    cU32_t expiryTick;
+
+    /** Callback class, 0 when node is free */
+    cU16_t classId;
+
+    /** Node is linked on timing wheel */
+    cU16_t running;
+
+}CompactTimerNode_t;
+
+/**
+ * @brief   Memory used by compact timers
+ */
+typedef struct
+{
+    /** Number of timer nodes */
+    cU32_t capacity;
+
+    /** Number of allocated timers */
+    cU32_t allocated;
+
+    /** Number of running timers */
+    cU32_t running;
+
+    /** Bytes of node array */
+    cU64_t nodeBytes;
+
+    /** Bytes of tag side table, 0 when tags are disabled */
+    cU64_t tagBytes;
+
+    /** Bytes of timing wheel */
+    cU64_t wheelBytes;
+
+    /** Bytes of callback class table */
+    cU64_t classBytes;
+
+    /** Total bytes */
+    cU64_t totalBytes;
+
+    /** Total bytes divided by capacity */
+    cDouble_t bytesPerTimer;
+
+}CompactTimerFootprint_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e CompactTimer_Init(cU32_t capacity, cU32_t wheelSlots, cBool withTags);
+
+void CompactTimer_Exit(void);
+
+cStatus_e CompactTimer_RegisterClass(void (*callback)(void *classCtx, cU32_t timerId, cU32_t tag), void *classCtx,
+                                     cU16_t *pClassId);
+
+cStatus_e CompactTimer_Alloc(cU16_t classId, cU32_t tag, cU32_t *pTimerId);
+
+void CompactTimer_Free(cU32_t timerId);
+
+cStatus_e CompactTimer_Start(cU32_t timerId, cU32_t expireAfterMs);
+
+void CompactTimer_Stop(cU32_t timerId);
+
+cBool CompactTimer_IsRunning(cU32_t timerId);
+
+void CompactTimer_Tick(void);
+
+void CompactTimer_GetFootprint(CompactTimerFootprint_t *pFootprint);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
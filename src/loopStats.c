@@ -0,0 +1,352 @@
+/*****************************************************************************
+ * @file    loopStats.c
+ * @author  Kshitij Mistry
+ * @brief   Super loop utilization statistics implementation file.
+ *
+ * This file implements windowed time counters and accounting of super loop phases. Phases can
+ * be nested (task timer expiry runs inside task dispatch), time of nested phase is excluded from
+ * its parent, so that phases never overlap. Reset is O(1): it starts new epoch and every counter
+ * of older epoch is treated as zero.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_def.h"
+#include "common_utils.h"
+#include "loopStats.h"
+#include <string.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Max nesting of loop phases */
+#define PHASE_NESTING_MAX           (4)
+
+/** Nano seconds in 1 sec */
+#define NANO_SECONDS_PER_SECOND     (1000000000LL)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Loop phase which is in progress
+ */
+typedef struct
+{
+    /** Phase */
+    LoopPhase_e phase;
+
+    /** Monotonic time at which phase began */
+    cU64_t beginTimeNs;
+
+    /** Time spent in nested phases */
+    cU64_t nestedNs;
+
+}PhaseFrame_t;
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Enabled measurements (LOOP_STATS_xxx) */
+static cU32_t gEnabledFlags = 0;
+
+/** Current reset epoch, counters start with epoch zero which is never current */
+static cU32_t gEpoch = 0;
+
+/** Monotonic time of last reset */
+static cU64_t gResetTimeNs = 0;
+
+/** Time counters of loop phases */
+static LoopStatsCounter_t gPhaseCounters[LOOP_PHASE_MAX];
+
+/** Phases which are in progress */
+static PhaseFrame_t gPhaseStack[PHASE_NESTING_MAX];
+
+/** Nesting depth of phases in progress (may exceed PHASE_NESTING_MAX, deeper phases are not measured) */
+static cU32_t gPhaseDepth = 0;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static cU64_t getSecondSinceReset(cU64_t curTimeNs);
+
+static cU32_t getWindowSeconds(LoopStatsWindow_e window);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Enable or disable measurements
+ * @param flags - LOOP_STATS_PHASES and/or LOOP_STATS_TASK_CPU_TIME, 0 to disable
+ * @note Statistics are reset when measurements are enabled for first time
+ */
+void LoopStats_Enable(cU32_t flags)
+{
+    if ((0 != flags) && (0 == gEpoch))
+    {
+        LoopStats_Reset();
+    }
+
+    gEnabledFlags = flags;
+    gPhaseDepth = 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get enabled measurements
+ * @return Enabled measurements (LOOP_STATS_xxx)
+ */
+cU32_t LoopStats_GetEnabled(void)
+{
+    return (gEnabledFlags);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Reset all phase and task counters
+ */
+void LoopStats_Reset(void)
+{
+    gEpoch++;
+    gResetTimeNs = Clock_ReadNanoSec();
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Mark beginning of loop phase
+ * @param phase - Loop phase
+ * @param curTimeNs - Current monotonic time in nanosec
+ */
+void LoopStats_PhaseBegin(LoopPhase_e phase, cU64_t curTimeNs)
+{
+    if ((0 == (gEnabledFlags & LOOP_STATS_PHASES)) || (phase >= LOOP_PHASE_MAX))
+    {
+        return;
+    }
+
+    if (gPhaseDepth < PHASE_NESTING_MAX)
+    {
+        gPhaseStack[gPhaseDepth].phase = phase;
+        gPhaseStack[gPhaseDepth].beginTimeNs = curTimeNs;
+        gPhaseStack[gPhaseDepth].nestedNs = 0;
+    }
+
+    gPhaseDepth++;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Mark end of loop phase which began last
+ * @param curTimeNs - Current monotonic time in nanosec
+ */
+void LoopStats_PhaseEnd(cU64_t curTimeNs)
+{
+    PhaseFrame_t *pFrame;
+    cU64_t elapsedNs;
+
+    if ((0 == (gEnabledFlags & LOOP_STATS_PHASES)) || (0 == gPhaseDepth))
+    {
+        return;
+    }
+
+    gPhaseDepth--;
+    if (gPhaseDepth >= PHASE_NESTING_MAX)
+    {
+        return;
+    }
+
+    pFrame = &gPhaseStack[gPhaseDepth];
+    elapsedNs = (curTimeNs > pFrame->beginTimeNs) ? (curTimeNs - pFrame->beginTimeNs) : 0;
+
+    /* Only exclusive time of phase is accounted, nested phases have accounted their own */
+    LoopStats_CounterAdd(&gPhaseCounters[pFrame->phase], curTimeNs,
+                         (elapsedNs > pFrame->nestedNs) ? (elapsedNs - pFrame->nestedNs) : 0);
+
+    if (gPhaseDepth > 0)
+    {
+        gPhaseStack[gPhaseDepth - 1].nestedNs += elapsedNs;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Account time of loop phase which is measured by caller
+ * @param phase - Loop phase
+ * @param curTimeNs - Current monotonic time in nanosec
+ * @param elapsedNs - Time spent in phase
+ */
+void LoopStats_AddPhaseTime(LoopPhase_e phase, cU64_t curTimeNs, cU64_t elapsedNs)
+{
+    if ((0 == (gEnabledFlags & LOOP_STATS_PHASES)) || (phase >= LOOP_PHASE_MAX))
+    {
+        return;
+    }
+
+    LoopStats_CounterAdd(&gPhaseCounters[phase], curTimeNs, elapsedNs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get time spent in each loop phase in a window
+ * @param window - Window of statistics
+ * @param pUsage - Structure to which usage will get copied
+ */
+void LoopStats_GetPhaseUsage(LoopStatsWindow_e window, LoopPhaseUsage_t *pUsage)
+{
+    cU64_t curTimeNs;
+    cU64_t curSec;
+    cU64_t coveredNs = 0;
+    cU32_t phase;
+
+    if ((NULL == pUsage) || (window >= LOOP_STATS_WINDOW_MAX))
+    {
+        return;
+    }
+
+    memset(pUsage, 0, sizeof(LoopPhaseUsage_t));
+    if (0 == gEpoch)
+    {
+        return;
+    }
+
+    curTimeNs = Clock_ReadNanoSec();
+    curSec = getSecondSinceReset(curTimeNs);
+
+    if (LOOP_STATS_WINDOW_TOTAL == window)
+    {
+        pUsage->windowNs = curTimeNs - gResetTimeNs;
+    }
+    else
+    {
+        /* Only completed seconds are part of window */
+        pUsage->windowNs = ((curSec < getWindowSeconds(window)) ? curSec : getWindowSeconds(window)) * NANO_SECONDS_PER_SECOND;
+    }
+
+    for (phase = 0; phase < LOOP_PHASE_MAX; phase++)
+    {
+        pUsage->phaseNs[phase] = LoopStats_CounterGet(&gPhaseCounters[phase], window);
+        coveredNs += pUsage->phaseNs[phase];
+    }
+
+    pUsage->otherNs = (pUsage->windowNs > coveredNs) ? (pUsage->windowNs - coveredNs) : 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Add time in windowed counter
+ * @param pCounter - Windowed counter
+ * @param curTimeNs - Current monotonic time in nanosec
+ * @param elapsedNs - Time to be added
+ */
+void LoopStats_CounterAdd(LoopStatsCounter_t *pCounter, cU64_t curTimeNs, cU64_t elapsedNs)
+{
+    cU64_t curSec = getSecondSinceReset(curTimeNs);
+    cU64_t sec;
+
+    if (pCounter->epoch != gEpoch)
+    {
+        memset(pCounter, 0, sizeof(LoopStatsCounter_t));
+        pCounter->epoch = gEpoch;
+        pCounter->lastSec = curSec;
+    }
+
+    if (curSec > pCounter->lastSec)
+    {
+        /* Clear buckets of seconds in which counter was not updated */
+        if ((curSec - pCounter->lastSec) >= LOOP_STATS_BUCKETS)
+        {
+            memset(pCounter->bucketNs, 0, sizeof(pCounter->bucketNs));
+        }
+        else
+        {
+            for (sec = pCounter->lastSec + 1; sec <= curSec; sec++)
+            {
+                pCounter->bucketNs[sec % LOOP_STATS_BUCKETS] = 0;
+            }
+        }
+
+        pCounter->lastSec = curSec;
+    }
+
+    pCounter->bucketNs[pCounter->lastSec % LOOP_STATS_BUCKETS] += elapsedNs;
+    pCounter->totalNs += elapsedNs;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get accumulated time of windowed counter
+ * @param pCounter - Windowed counter
+ * @param window - Window of statistics
+ * @return Accumulated time in nanosec
+ */
+cU64_t LoopStats_CounterGet(const LoopStatsCounter_t *pCounter, LoopStatsWindow_e window)
+{
+    cU64_t curSec;
+    cU64_t sec;
+    cU64_t sumNs = 0;
+    cU32_t windowSec;
+
+    if ((NULL == pCounter) || (pCounter->epoch != gEpoch) || (0 == gEpoch))
+    {
+        return (0);
+    }
+
+    if (LOOP_STATS_WINDOW_TOTAL == window)
+    {
+        return (pCounter->totalNs);
+    }
+
+    curSec = getSecondSinceReset(Clock_ReadNanoSec());
+    windowSec = getWindowSeconds(window);
+
+    for (sec = (curSec > windowSec) ? (curSec - windowSec) : 0; sec < curSec; sec++)
+    {
+        /* Bucket is valid only if it was not recycled for later second */
+        if ((sec <= pCounter->lastSec) && ((pCounter->lastSec - sec) < LOOP_STATS_BUCKETS))
+        {
+            sumNs += pCounter->bucketNs[sec % LOOP_STATS_BUCKETS];
+        }
+    }
+
+    return (sumNs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get second since last reset
+ * @param curTimeNs - Current monotonic time in nanosec
+ * @return Second since reset
+ */
+static cU64_t getSecondSinceReset(cU64_t curTimeNs)
+{
+    return (curTimeNs > gResetTimeNs) ? ((curTimeNs - gResetTimeNs) / NANO_SECONDS_PER_SECOND) : 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get length of window in seconds
+ * @param window - Window of statistics
+ * @return Window length in seconds
+ */
+static cU32_t getWindowSeconds(LoopStatsWindow_e window)
+{
+    switch (window)
+    {
+        case LOOP_STATS_WINDOW_1SEC:
+            return (1);
+
+        case LOOP_STATS_WINDOW_10SEC:
+            return (10);
+
+        default:
+            return (LOOP_STATS_BUCKETS);
+    }
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * @file    loopStats.h
+ * @author  Kshitij Mistry
+ * @brief   Super loop utilization statistics header file.
+ *
+ * This header file defines the interface to measure how wall time of scheduler super loop is
+ * split between tick update, task dispatch, task timer expiry and sleep. Time is accumulated in
+ * one second buckets, so that utilization can be read for last 1, 10 and 60 seconds as well as
+ * since last reset. The same windowed counter is used by scheduler for per task wall and CPU time.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Number of one second buckets kept by windowed counter (longest window) */
+#define LOOP_STATS_BUCKETS          (60)
+
+/** Measure time of super loop phases */
+#define LOOP_STATS_PHASES           (1U << 0)
+
+/** Measure on-CPU time of every task execution (costs two CLOCK_THREAD_CPUTIME_ID reads per task) */
+#define LOOP_STATS_TASK_CPU_TIME    (1U << 1)
+
+/*****************************************************************************
+ * ENUMS
+ *****************************************************************************/
+/**
+ * @brief   Phases of super loop
+ */
+typedef enum
+{
+    /** Scheduler_UpdateTick */
+    LOOP_PHASE_UPDATE_TICK = 0,
+
+    /** Scheduler_ExecuteTasksReadyToRun excluding task timer expiry */
+    LOOP_PHASE_DISPATCH,
+
+    /** TaskTimer_Tick */
+    LOOP_PHASE_TIMER_EXPIRY,
+
+    /** Time from Scheduler_GetDynamicSleep till next Scheduler_UpdateTick */
+    LOOP_PHASE_SLEEP,
+
+    /** Number of phases */
+    LOOP_PHASE_MAX
+
+}LoopPhase_e;
+
+/**
+ * @brief   Windows in which statistics can be read
+ */
+typedef enum
+{
+    /** Last completed second */
+    LOOP_STATS_WINDOW_1SEC = 0,
+
+    /** Last 10 completed seconds */
+    LOOP_STATS_WINDOW_10SEC,
+
+    /** Last 60 completed seconds */
+    LOOP_STATS_WINDOW_60SEC,
+
+    /** Since last reset */
+    LOOP_STATS_WINDOW_TOTAL,
+
+    /** Number of windows */
+    LOOP_STATS_WINDOW_MAX
+
+}LoopStatsWindow_e;
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Time counter accumulated in one second buckets
+ */
+typedef struct
+{
+    /** Reset epoch in which counter was last updated, older epoch means counter is zero */
+    cU32_t epoch;
+
+    /** Second (since reset) of last update */
+    cU64_t lastSec;
+
+    /** Accumulated time since reset in nanosec */
+    cU64_t totalNs;
+
+    /** Accumulated time of each second in nanosec */
+    cU64_t bucketNs[LOOP_STATS_BUCKETS];
+
+}LoopStatsCounter_t;
+
+/**
+ * @brief   Utilization of super loop phases in a window
+ */
+typedef struct
+{
+    /** Length of window in nanosec (shorter than requested if statistics are younger than window) */
+    cU64_t windowNs;
+
+    /** Time spent in each phase in nanosec */
+    cU64_t phaseNs[LOOP_PHASE_MAX];
+
+    /** Time of window not covered by any phase (application work in super loop) */
+    cU64_t otherNs;
+
+}LoopPhaseUsage_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+void LoopStats_Enable(cU32_t flags);
+
+cU32_t LoopStats_GetEnabled(void);
+
+void LoopStats_Reset(void);
+
+void LoopStats_PhaseBegin(LoopPhase_e phase, cU64_t curTimeNs);
+
+void LoopStats_PhaseEnd(cU64_t curTimeNs);
+
+void LoopStats_AddPhaseTime(LoopPhase_e phase, cU64_t curTimeNs, cU64_t elapsedNs);
+
+void LoopStats_GetPhaseUsage(LoopStatsWindow_e window, LoopPhaseUsage_t *pUsage);
+
+void LoopStats_CounterAdd(LoopStatsCounter_t *pCounter, cU64_t curTimeNs, cU64_t elapsedNs);
+
+cU64_t LoopStats_CounterGet(const LoopStatsCounter_t *pCounter, LoopStatsWindow_e window);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -12,9 +12,21 @@
 /*****************************************************************************
  * INCLUDES
  *****************************************************************************/
+#include "asyncExecutor.h"
+#include "common_clock.h"
 #include "common_def.h"
+#include "common_probe.h"
 #include "common_utils.h"
 #include "scheduler.h"
+#include "schedulerCoord.h"
+#include "schedulerIo.h"
+#include "schedulerRecord.h"
+#include "schedulerWatchdog.h"
+#include "taskTimer.h"
+#include "workerPool.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 /*****************************************************************************
@@ -23,12 +35,42 @@
 /** Maximum number of tasks in allowed in the scheduler list */
 #define	SCHEDULED_TASKS_MAX         10
 
+/* Task dependencies are kept as bit mask of task list indexes */
+_Static_assert(SCHEDULED_TASKS_MAX <= 16, "SCHEDULED_TASKS_MAX must fit in dependsOnMask");
+
 /** Maximum allowed clock resolution by platform should not exceed 1000 millisec */
 #define CLOCK_RESOLUTION_MS_MAX     1000
 
 /** Minimum sleep of application super loop in ns */
 #define	BASE_SLEEP_TIME_IN_NS       (1000000LL)
 
+/** Nano seconds in 1 sec */
+#define NANO_SECONDS_PER_SECOND     (1000000000LL)
+
+/** Nano seconds in 1 min */
+#define NANO_SECONDS_PER_MINUTE     (60 * NANO_SECONDS_PER_SECOND)
+
+/** Maximum number of pending one-shot jobs */
+#define SCHEDULED_JOBS_MAX          32
+
+/** Async task body is not running */
+#define ASYNC_STATE_IDLE            0
+
+/** Async task body is running */
+#define ASYNC_STATE_RUNNING         1
+
+/** Async task body is running and one more release is waiting for it */
+#define ASYNC_STATE_QUEUED          2
+
+/** Adaptive task has not reported in its current run */
+#define WORK_REPORT_NONE            0
+
+/** Adaptive task found work in its current run */
+#define WORK_REPORT_FOUND           1
+
+/** Adaptive task was idle in its current run */
+#define WORK_REPORT_IDLE            2
+
 /*****************************************************************************
  * VARIABLES
  *****************************************************************************/
@@ -59,14 +101,211 @@ static cU8_t gTaskCnt = 0;
 /** Time reference from beginning of caller super loop */
 static cI64_t gBeginTime = 0;
 
+/** Sleep until next task deadline instead of every timer tick */
+static cBool gWakeupCoalescingF = c_FALSE;
+
+/** Wakeup statistics collected while coalescing is enabled */
+static SchedulerWakeupStats_t gWakeupStats;
+
+/** Overload controller configuration, controller is disabled when window is zero */
+static SchedulerOverloadConfig_t gOverloadConfig;
+
+/** Overload controller state */
+static SchedulerOverloadState_t gOverloadState = {SCHEDULER_LOAD_NORMAL, 1, 0, 0, 0, 0, 0};
+
+/** Monotonic time at which current super loop iteration started */
+static cU64_t gLoopIterStartNanoSec = 0;
+
+/** Monotonic time at which current overload measurement window started */
+static cU64_t gOverloadWindowStartNanoSec = 0;
+
+/** Time spent outside of sleep in current overload measurement window */
+static cU64_t gOverloadBusyNanoSec = 0;
+
+/** Max lateness of super loop in current overload measurement window */
+static cI64_t gOverloadMaxLateNanoSec = 0;
+
+/** Consecutive windows above high watermark */
+static cU32_t gOverloadHighWindowCnt = 0;
+
+/** Consecutive windows below low watermark */
+static cU32_t gOverloadLowWindowCnt = 0;
+
+/** Monotonic time at which last loop iteration went to sleep */
+static cU64_t gLoopIterEndNanoSec = 0;
+
+/** Super loop statistics */
+static SchedulerLoopStats_t gLoopStats;
+
+/** Preallocated one-shot jobs */
+static ScheduleJob_t gJobPool[SCHEDULED_JOBS_MAX];
+
+/** Free jobs */
+static ScheduleJob_t *gJobFreeHead = NULL;
+
+/** Jobs to run on next iteration, in order of posting */
+static ScheduleJob_t *gJobReadyHead = NULL;
+
+/** Last job to run on next iteration */
+static ScheduleJob_t *gJobReadyTail = NULL;
+
+/** Delayed jobs sorted by due time */
+static ScheduleJob_t *gJobDelayedHead = NULL;
+
+/** Protects graph execution state while tasks run on worker threads */
+static pthread_mutex_t gGraphMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Signalled when a task of graph completes */
+static pthread_cond_t gGraphCond = PTHREAD_COND_INITIALIZER;
+
+/** Tasks released in current graph execution */
+static cU16_t gGraphReleasedMask = 0;
+
+/** Tasks taken by a thread in current graph execution */
+static cU16_t gGraphClaimedMask = 0;
+
+/** Tasks completed in current graph execution */
+static cU16_t gGraphDoneMask = 0;
+
+/** Loop statistics flags of current graph execution */
+static cU32_t gGraphLoopStatsFlags = 0;
+
+/** Graph execution statistics */
+static SchedulerGraphStats_t gGraphStats;
+
+/** Released tasks are being dispatched, task list must not move till end of pass */
+static cBool gDispatchingF = c_FALSE;
+
+/** Tasks deregistered during dispatch (bit per task list index), removed at end of pass */
+static cU16_t gTaskTombstoneMask = 0;
+
+/** Watchdog start count for which watchdog slots of tasks were resolved */
+static cU32_t gWatchdogStartCnt = 0;
+
+/** Timer ticks elapsed since reset, task phases are relative to it */
+static cU64_t gTickCnt = 0;
+
+/** Automatic phase assignment of tasks which share an interval */
+static SchedulerStagger_e gStaggerMode = SCHEDULER_STAGGER_NONE;
+
+/** Load on every tick of one second, used while phases are assigned */
+static cU64_t gPhaseLoad[CLOCK_RESOLUTION_MS_MAX];
+
+/** Async task statistics */
+static SchedulerAsyncStats_t gAsyncStats;
+
+/** Bodies handed to executor whose completion has not run yet, kept apart from task list so that
+ *  they outlive deregistration of their task */
+static AsyncExecutorJob_t gAsyncInFlight[ASYNC_EXECUTOR_QUEUE_MAX];
+
+/** Number of bodies in gAsyncInFlight */
+static cU32_t gAsyncInFlightCnt = 0;
+
+/** Executor notify fd watched by loop, -1 when not watched */
+static cI32_t gAsyncNotifyFd = -1;
+
+/** Index of task whose function runs on this thread, -1 outside of task function */
+static __thread cI16_t tRunningTaskId = -1;
+
+/** This thread runs super loop, worker threads of task graph never set it */
+static __thread cBool tLoopThreadF = c_FALSE;
+
 /*****************************************************************************
  * FUNCTION DECLARATIONS
  *****************************************************************************/
 
-static cBool isTaskAlreadyInList(void (*callback)(void));
+static cStatus_e registerTask(void (*callback)(void), void (*ctxCallback)(void *ctx), void *ctx, TimeInterval_e runInterval);
+
+static cStatus_e deregisterTask(void (*callback)(void), void (*ctxCallback)(void *ctx), void *ctx);
+
+static cStatus_e setTaskSlack(cI16_t taskId, cU32_t slackMs);
+
+static cStatus_e setTaskSheddable(cI16_t taskId, cBool sheddable);
+
+static cStatus_e setTaskParallelSafe(cI16_t taskId, cBool parallelSafe);
+
+static cStatus_e setTaskPhase(cI16_t taskId, cU32_t phaseMs);
+
+static cStatus_e setTaskPeriod(cI16_t taskId, cU32_t periodMs);
+
+static cStatus_e setTaskBackoff(cI16_t taskId, cU32_t maxPeriodMs);
+
+static void changeTaskPeriodTicks(cU8_t taskId, cU16_t periodTicks);
+
+static void applyWorkReport(cU8_t taskId);
+
+static cU32_t getTaskPeriodTicks(cU8_t taskId);
+
+static cU64_t getTaskPhaseCost(cU8_t taskId);
+
+static void addTaskPhaseLoad(cU8_t taskId);
+
+static cU16_t pickTaskPhase(cU8_t taskId);
+
+static void applyTaskPhase(cU8_t taskId, cU16_t phaseTicks);
+
+static void assignTaskPhases(void);
+
+static void assignNewTaskPhase(cU8_t taskId);
+
+static void updateOverloadController(cU64_t curTimeNs, cI64_t lateNs);
+
+static cI16_t findTask(void (*callback)(void), void (*ctxCallback)(void *ctx), void *ctx);
+
+static cBool isTaskSlotFree(const ScheduleTask_t *pTask);
+
+static void resetTaskEntry(ScheduleTask_t *pTask);
 
 static void reshuffleTaskList(void);
 
+static void removeTaskTombstones(void);
+
+static cU32_t getCoalescedSleepTicks(void);
+
+static cU32_t getTaskDueTicks(cU8_t taskId);
+
+static cU32_t getCriticalDueTicks(void);
+
+static cU32_t getTicksToWallClockBoundary(cI64_t boundaryNs);
+
+static cU32_t getTaskStaggerTicks(cU8_t taskId, cU32_t periodTicks);
+
+static void joinCoordinatorFromEnv(void);
+
+static void initJobPool(void);
+
+static cStatus_e addTaskDependency(cI16_t beforeId, cI16_t afterId);
+
+static void removeTaskFromDependencies(cU8_t removedId);
+
+static void runTask(cU8_t taskId, cU32_t loopStatsFlags);
+
+static const void *getTaskFunction(cU8_t taskId);
+
+static void resolveTaskWatchdogSlots(void);
+
+static void executeTaskGraph(cU16_t releasedMask, cU32_t loopStatsFlags);
+
+static void graphWorker(void *arg);
+
+static ScheduleJob_t *allocJob(void (*callback)(void *ctx), void *ctx);
+
+static void runDeferredJobs(void);
+
+static cU32_t getTicksToNextJob(void);
+
+static void releaseAsyncTask(cU8_t taskId);
+
+static void submitAsyncTask(cU8_t taskId);
+
+static cBool isAsyncBodyInFlight(void (*body)(void *ctx), void *ctx);
+
+static void runAsyncCompletions(void);
+
+static void onAsyncNotify(cI32_t fd, cU32_t events, void *ctx);
+
+static void noAsyncCompletion(void *ctx);
+
 /*****************************************************************************
  * FUNCTION DEFINATIONS
  *****************************************************************************/
@@ -83,13 +322,20 @@ cBool Scheduler_Init(cU32_t timerResolutionMs, cU32_t *pMaxPermittedDelayMs)
 
     for (taskId = 0; taskId < SCHEDULED_TASKS_MAX; taskId++)
     {
-        gTaskList[taskId].callback = NULL;
-        gTaskList[taskId].runInterval = 0;
-        gTaskList[taskId].readyToRun = c_FALSE;
-        gTaskList[taskId].clockTick.clockTicksCnt = 0;
-        gTaskList[taskId].clockTick.clockTicksThreshold = 0;
+        if (c_FALSE == isTaskSlotFree(&gTaskList[taskId]))
+        {
+            SchedulerWatchdog_ReleaseSlot(gTaskList[taskId].watchdogSlot);
+        }
+
+        resetTaskEntry(&gTaskList[taskId]);
     }
 
+    gTaskTombstoneMask = 0;
+    gDispatchingF = c_FALSE;
+    memset(&gAsyncStats, 0, sizeof(gAsyncStats));
+
+    initJobPool();
+
     if ((0 == timerResolutionMs) || (timerResolutionMs >= CLOCK_RESOLUTION_MS_MAX))
     {
         return (c_FALSE);
@@ -110,6 +356,9 @@ cBool Scheduler_Init(cU32_t timerResolutionMs, cU32_t *pMaxPermittedDelayMs)
 
     DPRINT("cpu clock resolution: [sec=%ld], [n_sec=%ld]", resolution.tv_sec, resolution.tv_nsec);
 
+    /* Select fast clock source used for timekeeping of super loop */
+    Clock_Init();
+
     /* Validate the resolution */
     if (((cI64_t)timerResolutionMs) < (resolution.tv_nsec / NANO_SECONDS_PER_MILLI_SECOND))
     {
@@ -123,6 +372,9 @@ cBool Scheduler_Init(cU32_t timerResolutionMs, cU32_t *pMaxPermittedDelayMs)
     /* Save the Timer Resolution in nano sec */
     gTimerResolutionInNanoSec = (cU64_t) (((cU64_t)gTimerResolutionInMilliSec) * NANO_SECONDS_PER_MILLI_SECOND);
 
+    /* Timer resolution may be coarsened later by overload controller */
+    gOverloadState.effectiveResolutionMs = gTimerResolutionInMilliSec;
+
     if (NULL != pMaxPermittedDelayMs)
     {
         /* Save max permitted delay in milli sec */
@@ -134,6 +386,9 @@ cBool Scheduler_Init(cU32_t timerResolutionMs, cU32_t *pMaxPermittedDelayMs)
         gMaxPermittedDelayMilliSec = gTimerResolutionInMilliSec * 100;
     }
 
+    /* Host-wide wakeup coordination is opted in by environment, so processes need no code change */
+    joinCoordinatorFromEnv();
+
     return (c_TRUE);
 }
 
@@ -146,322 +401,2597 @@ cBool Scheduler_Init(cU32_t timerResolutionMs, cU32_t *pMaxPermittedDelayMs)
  */
 cStatus_e Scheduler_RegisterTask(void (*callback)(void), TimeInterval_e runInterval)
 {
-    cBool isRegistered = c_FALSE;
-    cU8_t taskId;
-
     /* validate arguments */
     if (NULL == callback)
     {
         return (cStatus_INVALID_ARG);
     }
 
-    /* Check if max tasks are already registered */
-    if (gTaskCnt >= SCHEDULED_TASKS_MAX)
+    return registerTask(callback, NULL, NULL, runInterval);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that register Tasks which takes application context (add it to list)
+ * @param (*callback) - Address of function to be registered
+ * @param ctx - Application context passed to callback
+ * @param runInterval - Interval for execution of task
+ * @return Error code to indicate success or failure of function
+ * @note Same callback can be registered multiple times with different context
+ */
+cStatus_e Scheduler_RegisterTaskWithCtx(void (*callback)(void *ctx), void *ctx, TimeInterval_e runInterval)
+{
+    /* validate arguments */
+    if (NULL == callback)
     {
-        return (cStatus_NO_RESOURCE);
+        return (cStatus_INVALID_ARG);
     }
 
-    if (c_TRUE == isTaskAlreadyInList(callback))
+    return registerTask(NULL, callback, ctx, runInterval);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that deregister Tasks (remove from list)
+ * @param (*callback) - Address of function to be deregistered
+ * @return Error code to indicate success or failure of function
+ * @note It can be called from task callback, deregistered task does not run again and its entry is
+ *       removed at end of dispatch pass. Lookup and removal scan the list of at most
+ *       SCHEDULED_TASKS_MAX tasks, so they are O(N) with small N.
+ */
+cStatus_e Scheduler_DeregisterTask(void (*callback)(void))
+{
+    /* validate argument */
+    if (NULL == callback)
     {
-        return (cStatus_OPERATION_FAIL);
+        return (cStatus_INVALID_ARG);
     }
 
-    for (taskId = 0; taskId < SCHEDULED_TASKS_MAX; taskId++)
-    {
-        if (NULL != gTaskList[taskId].callback)
-        {
-            continue;
-        }
+    return deregisterTask(callback, NULL, NULL);
+}
 
-        gTaskList[taskId].callback = callback;
-        gTaskList[taskId].runInterval = runInterval;
-        gTaskList[taskId].readyToRun = c_FALSE;
-        gTaskList[taskId].clockTick.clockTicksCnt = 0;
-        gTaskList[taskId].clockTick.clockTicksThreshold = 0;
-        isRegistered = c_TRUE;
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that deregister Tasks which takes application context (remove from list)
+ * @param (*callback) - Address of function to be deregistered
+ * @param ctx - Application context given at the time of registration
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_DeregisterTaskWithCtx(void (*callback)(void *ctx), void *ctx)
+{
+    /* validate argument */
+    if (NULL == callback)
+    {
+        return (cStatus_INVALID_ARG);
+    }
 
-        switch (runInterval)
-        {
-            case TIME_INTERVAL_10MS:
-                gTaskList[taskId].clockTick.clockTicksThreshold = (10 / gTimerResolutionInMilliSec);
-                break;
+    return deregisterTask(NULL, callback, ctx);
+}
 
-            case TIME_INTERVAL_20MS:
-                gTaskList[taskId].clockTick.clockTicksThreshold = (20 / gTimerResolutionInMilliSec);
-                break;
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that checks if task which takes application context is registered
+ * @param (*callback) - Address of task function
+ * @param ctx - Application context given at the time of registration
+ * @return Returns true if task is registered, false otherwise
+ */
+cBool Scheduler_IsTaskRegisteredWithCtx(void (*callback)(void *ctx), void *ctx)
+{
+    if (NULL == callback)
+    {
+        return (c_FALSE);
+    }
 
-            case TIME_INTERVAL_100MS:
-                gTaskList[taskId].clockTick.clockTicksThreshold = (100 / gTimerResolutionInMilliSec);
-                break;
+    return (findTask(NULL, callback, ctx) >= 0) ? c_TRUE : c_FALSE;
+}
 
-            default:
-                /* we are not using TimerClockTick_t structure for tasks having run interval of more than 1 sec */
-                break;
-        }
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that runs job once on next super loop iteration
+ * @param (*callback) - Address of job function
+ * @param ctx - Application context passed to callback
+ * @return Error code to indicate success or failure of function
+ * @note Jobs run in order of posting after periodic tasks, no heap allocation is done
+ */
+cStatus_e Scheduler_RunOnce(void (*callback)(void *ctx), void *ctx)
+{
+    ScheduleJob_t *pJob = allocJob(callback, ctx);
 
-        /* Increase Tasks cnt */
-        gTaskCnt++;
-        break;
+    if (NULL == pJob)
+    {
+        return (NULL == callback) ? cStatus_INVALID_ARG : cStatus_NO_RESOURCE;
     }
 
-    if (c_FALSE == isRegistered)
+    pJob->dueTimeNs = 0;
+
+    if (NULL == gJobReadyTail)
     {
-        return (cStatus_OPERATION_FAIL);
+        gJobReadyHead = pJob;
+    }
+    else
+    {
+        gJobReadyTail->next = pJob;
     }
 
+    gJobReadyTail = pJob;
     return (cStatus_SUCCESS);
 }
 
 //----------------------------------------------------------------------------
 /**
- * @brief Function that deregister Tasks (remove from list)
- * @param (*callback) - Address of function to be deregistered
+ * @brief Function that runs job once after delay
+ * @param delayMs - Delay in millisec, job runs on first scheduler tick at or after it
+ * @param (*callback) - Address of job function
+ * @param ctx - Application context passed to callback
  * @return Error code to indicate success or failure of function
  */
-cStatus_e Scheduler_DeregisterTask(void (*callback)(void))
+cStatus_e Scheduler_RunAfter(cU32_t delayMs, void (*callback)(void *ctx), void *ctx)
 {
-    cU8_t taskId;
+    ScheduleJob_t *pJob;
+    ScheduleJob_t **ppNext;
 
-    /* validate argument */
-    if (NULL == callback)
+    if (0 == delayMs)
     {
-        return (cStatus_INVALID_ARG);
+        return (Scheduler_RunOnce(callback, ctx));
     }
 
-    /* If no tasks are registered, we can't deregister */
-    if (0 == gTaskCnt)
+    pJob = allocJob(callback, ctx);
+    if (NULL == pJob)
     {
-        return (cStatus_SUCCESS);
+        return (NULL == callback) ? cStatus_INVALID_ARG : cStatus_NO_RESOURCE;
     }
 
-    for (taskId = 0; taskId < SCHEDULED_TASKS_MAX; taskId++)
+    pJob->dueTimeNs = Clock_ReadNanoSec() + ((cU64_t)delayMs * NANO_SECONDS_PER_MILLI_SECOND);
+
+    /* Job goes after all jobs due before or at the same time, so equal delays keep posting order */
+    for (ppNext = &gJobDelayedHead; NULL != *ppNext; ppNext = &(*ppNext)->next)
     {
-        if (callback != gTaskList[taskId].callback)
+        if ((*ppNext)->dueTimeNs > pJob->dueTimeNs)
         {
-            continue;
+            break;
         }
-
-        gTaskList[taskId].readyToRun = c_FALSE;
-        gTaskList[taskId].runInterval = TIME_INTERVAL_NONE;
-        gTaskList[taskId].callback = NULL;
-        gTaskList[taskId].clockTick.clockTicksCnt = 0;
-        gTaskList[taskId].clockTick.clockTicksThreshold = 0;
-
-        /* Decrease Tasks cnt */
-        gTaskCnt--;
     }
 
-    /* Reshuffle Task List */
-    reshuffleTaskList();
-
+    pJob->next = *ppNext;
+    *ppNext = pJob;
     return (cStatus_SUCCESS);
 }
 
 //----------------------------------------------------------------------------
 /**
- * @brief Function that reset all timer event and saves start point
+ * @brief Function that makes a task wait for another task released on the same tick
+ * @param (*before) - Address of registered task function which runs first
+ * @param (*after) - Address of registered task function which runs once before has completed
+ * @return Error code to indicate success or failure of function
+ * @note Dependency is honored only when both tasks are released on the same tick
  */
-void Scheduler_Reset(void)
+cStatus_e Scheduler_AddTaskDependency(void (*before)(void), void (*after)(void))
 {
-    cU8_t taskId;
+    if ((NULL == before) || (NULL == after))
+    {
+        return (cStatus_INVALID_ARG);
+    }
 
-    /* Set begin time as current time for reference to calculate dynamic sleep */
-    gBeginTime = Utils_GetMonotonicTimeInNanoSec();
+    return (addTaskDependency(findTask(before, NULL, NULL), findTask(after, NULL, NULL)));
+}
 
-    /* Get the Time Since Epoch */
-    Utils_GetTimeSinceEpoch(&gLastTimeRefSinceEpoch);
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that makes a task with context wait for another task with context
+ * @param (*before) - Address of registered task function which runs first
+ * @param beforeCtx - Application context of before task
+ * @param (*after) - Address of registered task function which runs once before has completed
+ * @param afterCtx - Application context of after task
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_AddTaskDependencyWithCtx(void (*before)(void *ctx), void *beforeCtx, void (*after)(void *ctx), void *afterCtx)
+{
+    if ((NULL == before) || (NULL == after))
+    {
+        return (cStatus_INVALID_ARG);
+    }
 
-    /* Reset Last ref monotonic time */
-    gLastMonotonicTimeInNanoSec = Utils_GetMonotonicTimeInNanoSec();
+    return (addTaskDependency(findTask(NULL, before, beforeCtx), findTask(NULL, after, afterCtx)));
+}
 
-    /* Reset Elapsed nano sec */
-    gElapsedNanoSec = 0;
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that removes all dependencies between tasks
+ */
+void Scheduler_ClearTaskDependencies(void)
+{
+    cU8_t taskId;
 
-    /* Reset all Timer Eve clock tick count */
     for (taskId = 0; taskId < SCHEDULED_TASKS_MAX; taskId++)
     {
-        gTaskList[taskId].clockTick.clockTicksCnt = 0;
-        gTaskList[taskId].readyToRun = c_FALSE;
+        gTaskList[taskId].dependsOnMask = 0;
     }
-
-    DPRINT("reset scheduler timer");
 }
 
 //----------------------------------------------------------------------------
 /**
- * @brief Function that gets the the time and calculate difference to generate timer events
+ * @brief Function that sets number of worker threads which execute tasks of a release in parallel
+ * @param threadCnt - Number of worker threads in addition to loop thread, 0 to execute on loop thread only
+ * @return Error code to indicate success or failure of function
+ * @note Only tasks marked with Scheduler_SetTaskParallelSafe run on worker threads, all others stay on loop thread
  */
-void Scheduler_UpdateTick(void)
+cStatus_e Scheduler_SetWorkerThreads(cU8_t threadCnt)
 {
-    cU64_t curMonotonicTimeInNanSec = 0;
-    cU8_t taskId;
-    cU32_t timerEvents = 0;
-    struct tm curTimeStamp;
+    WorkerPool_Stop();
+
+    if (0 == threadCnt)
+    {
+        return (cStatus_SUCCESS);
+    }
+
+    return (WorkerPool_Start(threadCnt));
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that lets task run on worker threads
+ * @param (*callback) - Address of registered task function
+ * @param parallelSafe - true if task may run on worker thread, false to keep it on loop thread (default)
+ * @return Error code to indicate success or failure of function
+ * @note Task must not call scheduler or TaskTimer functions other than Scheduler_ReportWork, so
+ *       TaskTimer_Tick can not be marked
+ */
+cStatus_e Scheduler_SetTaskParallelSafe(void (*callback)(void), cBool parallelSafe)
+{
+    /* validate arguments */
+    if ((NULL == callback) || (!IS_VALID_BOOL(parallelSafe)) || ((TaskTimer_Tick == callback) && (c_TRUE == parallelSafe)))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskParallelSafe(findTask(callback, NULL, NULL), parallelSafe);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that lets task which takes application context run on worker threads
+ * @param (*callback) - Address of registered task function
+ * @param ctx - Application context given at the time of registration
+ * @param parallelSafe - true if task may run on worker thread, false to keep it on loop thread (default)
+ * @return Error code to indicate success or failure of function
+ * @note Task must not call scheduler or TaskTimer functions other than Scheduler_ReportWork
+ */
+cStatus_e Scheduler_SetTaskParallelSafeWithCtx(void (*callback)(void *ctx), void *ctx, cBool parallelSafe)
+{
+    /* validate arguments */
+    if ((NULL == callback) || (!IS_VALID_BOOL(parallelSafe)))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskParallelSafe(findTask(NULL, callback, ctx), parallelSafe);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that registers task whose body runs on background executor thread
+ * @param (*body) - Task body, runs on executor thread
+ * @param (*completion) - Runs on loop thread in a later iteration once body has returned, may be NULL
+ * @param ctx - Application context passed to body and completion
+ * @param runInterval - Interval at which task is released
+ * @param policy - Handling of release while previous body is still running
+ * @return Error code to indicate success or failure of function
+ * @note Body must not call scheduler or TaskTimer functions, completion may. Task is deregistered with
+ *       Scheduler_DeregisterTaskWithCtx(body, ctx), completion of a body already running still runs.
+ *       Same body and context can be registered again only once that completion has run, till then
+ *       cStatus_RESOURCE_BUSY is returned. Executor with one thread is started if none is running.
+ */
+cStatus_e Scheduler_RegisterAsyncTask(void (*body)(void *ctx), void (*completion)(void *ctx), void *ctx,
+                                      TimeInterval_e runInterval, SchedulerAsyncPolicy_e policy)
+{
+    cStatus_e status;
+    cI16_t taskId;
+
+    /* validate arguments */
+    if ((NULL == body) || (policy > SCHEDULER_ASYNC_QUEUE_ONE))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    /* New entry would start idle and run a second body next to the one of deregistered entry */
+    if (c_TRUE == isAsyncBodyInFlight(body, ctx))
+    {
+        return (cStatus_RESOURCE_BUSY);
+    }
+
+    if (0 == AsyncExecutor_GetThreadCount())
+    {
+        status = Scheduler_SetAsyncThreads(1);
+        if (cStatus_SUCCESS != status)
+        {
+            return (status);
+        }
+    }
+
+    status = registerTask(NULL, body, ctx, runInterval);
+    if (cStatus_SUCCESS != status)
+    {
+        return (status);
+    }
+
+    taskId = findTask(NULL, body, ctx);
+    gTaskList[taskId].asyncCompletion = (NULL != completion) ? completion : noAsyncCompletion;
+    gTaskList[taskId].asyncPolicy = (cU8_t)policy;
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets number of executor threads which run async task bodies
+ * @param threadCnt - Number of executor threads, 0 to stop executor
+ * @return Error code to indicate success or failure of function
+ * @note Blocks calling loop thread till running and queued bodies have returned, their completions run
+ *       before it returns. Call it at startup or shutdown, not from task callbacks of a running loop.
+ */
+cStatus_e Scheduler_SetAsyncThreads(cU8_t threadCnt)
+{
+    cStatus_e status;
+
+    if (threadCnt > ASYNC_EXECUTOR_THREADS_MAX)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (gAsyncNotifyFd >= 0)
+    {
+        Scheduler_UnwatchFd(gAsyncNotifyFd);
+        gAsyncNotifyFd = -1;
+    }
+
+    AsyncExecutor_Stop();
+    runAsyncCompletions();
+
+    if (0 == threadCnt)
+    {
+        return (cStatus_SUCCESS);
+    }
+
+    status = AsyncExecutor_Start(threadCnt);
+    if (cStatus_SUCCESS != status)
+    {
+        return (status);
+    }
+
+    /* Completions are also polled every iteration, watching only shortens their latency in Scheduler_WaitForEvents */
+    if (cStatus_SUCCESS == Scheduler_WatchFd(AsyncExecutor_GetNotifyFd(), SCHEDULER_FD_READABLE, onAsyncNotify, NULL))
+    {
+        gAsyncNotifyFd = AsyncExecutor_GetNotifyFd();
+    }
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gives statistics of async tasks
+ * @param pStats - Structure to which statistics will get copied
+ */
+void Scheduler_GetAsyncStats(SchedulerAsyncStats_t *pStats)
+{
+    if (NULL == pStats)
+    {
+        return;
+    }
+
+    *pStats = gAsyncStats;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gives statistics of releases executed as dependency graph
+ * @param pStats - Structure to which statistics will get copied
+ */
+void Scheduler_GetGraphStats(SchedulerGraphStats_t *pStats)
+{
+    if (NULL == pStats)
+    {
+        return;
+    }
+
+    *pStats = gGraphStats;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets how late a registered task may be released
+ * @param (*callback) - Address of registered task function
+ * @param slackMs - Tolerated release delay in millisec (rounded down to timer resolution)
+ * @return Error code to indicate success or failure of function
+ * @note Similar to linux timer_slack_ns, slack lets scheduler release the task together with other task
+ *       deadlines which falls in its slack window, so that super loop wakes up once for all of them.
+ */
+cStatus_e Scheduler_SetTaskSlack(void (*callback)(void), cU32_t slackMs)
+{
+    /* validate arguments */
+    if (NULL == callback)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskSlack(findTask(callback, NULL, NULL), slackMs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets how late a registered task which takes application context may be released
+ * @param (*callback) - Address of registered task function
+ * @param ctx - Application context given at the time of registration
+ * @param slackMs - Tolerated release delay in millisec (rounded down to timer resolution)
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_SetTaskSlackWithCtx(void (*callback)(void *ctx), void *ctx, cU32_t slackMs)
+{
+    /* validate arguments */
+    if (NULL == callback)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskSlack(findTask(NULL, callback, ctx), slackMs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that enables or disables wakeup coalescing of super loop
+ * @param enable - true to sleep until next task deadline, false to wake up on every timer tick
+ */
+void Scheduler_SetWakeupCoalescing(cBool enable)
+{
+    gWakeupCoalescingF = enable;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that selects how tasks which share an interval are spread over its ticks
+ * @param mode - Phase assignment mode
+ * @note Phases are assigned immediately and again on every Scheduler_Reset, task registered later gets the
+ *       least loaded phase. In balanced mode call it again once tasks have run for a while, so that phases
+ *       are derived from measured run times. 1 sec and 1 min tasks are spread over the ticks of one second
+ *       after wall clock boundary.
+ */
+void Scheduler_SetPhaseStaggering(SchedulerStagger_e mode)
+{
+    gStaggerMode = mode;
+
+    if (0 != gTimerResolutionInMilliSec)
+    {
+        assignTaskPhases();
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets release offset of a registered task from its interval boundary
+ * @param (*callback) - Address of registered task function
+ * @param phaseMs - Offset in millisec (rounded down to timer resolution), less than interval (1 sec for
+ *                  1 sec and 1 min tasks), SCHEDULER_PHASE_AUTO to hand task back to automatic assignment
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_SetTaskPhase(void (*callback)(void), cU32_t phaseMs)
+{
+    /* validate arguments */
+    if (NULL == callback)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskPhase(findTask(callback, NULL, NULL), phaseMs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets release offset of a registered task which takes application context
+ * @param (*callback) - Address of registered task function
+ * @param ctx - Application context given at the time of registration
+ * @param phaseMs - Offset in millisec, SCHEDULER_PHASE_AUTO for automatic assignment
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_SetTaskPhaseWithCtx(void (*callback)(void *ctx), void *ctx, cU32_t phaseMs)
+{
+    /* validate arguments */
+    if (NULL == callback)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskPhase(findTask(NULL, callback, ctx), phaseMs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gives wakeup statistics of super loop
+ * @param pStats - Structure to which statistics will get copied
+ */
+void Scheduler_GetWakeupStats(SchedulerWakeupStats_t *pStats)
+{
+    if (NULL == pStats)
+    {
+        return;
+    }
+
+    *pStats = gWakeupStats;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that marks task which may be stretched or skipped when super loop is overloaded
+ * @param (*callback) - Address of registered task function
+ * @param sheddable - true if task may be shed, false for critical task (default)
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_SetTaskSheddable(void (*callback)(void), cBool sheddable)
+{
+    /* validate arguments */
+    if ((NULL == callback) || (!IS_VALID_BOOL(sheddable)))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskSheddable(findTask(callback, NULL, NULL), sheddable);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that marks task which takes application context as sheddable
+ * @param (*callback) - Address of registered task function
+ * @param ctx - Application context given at the time of registration
+ * @param sheddable - true if task may be shed, false for critical task (default)
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_SetTaskSheddableWithCtx(void (*callback)(void *ctx), void *ctx, cBool sheddable)
+{
+    /* validate arguments */
+    if ((NULL == callback) || (!IS_VALID_BOOL(sheddable)))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskSheddable(findTask(NULL, callback, ctx), sheddable);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that changes period of registered task in place
+ * @param (*callback) - Address of registered task function
+ * @param periodMs - New period in millisec, multiple of timer resolution
+ * @return Error code to indicate success or failure of function
+ * @note Ticks elapsed since last release are kept, so task is next released one new period after its
+ *       last release (on next tick if that has passed). 1 sec and 1 min tasks are released on tick
+ *       count instead of wall clock boundary from then on.
+ */
+cStatus_e Scheduler_SetTaskPeriod(void (*callback)(void), cU32_t periodMs)
+{
+    /* validate arguments */
+    if (NULL == callback)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskPeriod(findTask(callback, NULL, NULL), periodMs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that changes period of registered task which takes application context in place
+ * @param (*callback) - Address of registered task function
+ * @param ctx - Application context given at the time of registration
+ * @param periodMs - New period in millisec, multiple of timer resolution
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_SetTaskPeriodWithCtx(void (*callback)(void *ctx), void *ctx, cU32_t periodMs)
+{
+    /* validate arguments */
+    if (NULL == callback)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskPeriod(findTask(NULL, callback, ctx), periodMs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that makes polling task adaptive, its period backs off while it reports no work
+ * @param (*callback) - Address of registered task function
+ * @param maxPeriodMs - Longest period in millisec, 0 to disable backoff and restore base period
+ * @return Error code to indicate success or failure of function
+ * @note Current period is base period. Each run which reports idle (Scheduler_ReportWork) doubles the
+ *       period up to maxPeriodMs, a run which reports work restores base period.
+ */
+cStatus_e Scheduler_SetTaskBackoff(void (*callback)(void), cU32_t maxPeriodMs)
+{
+    /* validate arguments */
+    if (NULL == callback)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskBackoff(findTask(callback, NULL, NULL), maxPeriodMs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that makes polling task which takes application context adaptive
+ * @param (*callback) - Address of registered task function
+ * @param ctx - Application context given at the time of registration
+ * @param maxPeriodMs - Longest period in millisec, 0 to disable backoff and restore base period
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_SetTaskBackoffWithCtx(void (*callback)(void *ctx), void *ctx, cU32_t maxPeriodMs)
+{
+    /* validate arguments */
+    if (NULL == callback)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    return setTaskBackoff(findTask(NULL, callback, ctx), maxPeriodMs);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that reports from task function whether this run found work
+ * @param foundWork - true if task found work, false if it was idle
+ * @return Error code to indicate success or failure of function
+ * @note Period of adaptive task is adjusted once task function returns, last report of run wins
+ */
+cStatus_e Scheduler_ReportWork(cBool foundWork)
+{
+    if (!IS_VALID_BOOL(foundWork))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    /* Called from outside of task function */
+    if (tRunningTaskId < 0)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    gTaskList[tRunningTaskId].workReport = (c_TRUE == foundWork) ? WORK_REPORT_FOUND : WORK_REPORT_IDLE;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that enables overload controller of super loop
+ * @param pConfig - Controller configuration, NULL to disable controller and restore normal operation
+ * @return Error code to indicate success or failure of function
+ * @note When loop utilization or lateness stays above configured limit for enterWindows consecutive windows,
+ *       tick is coarsened by doubling tick multiplier (up to maxTickMultiplier) and sheddable tasks are released
+ *       only once per tick multiplier periods. Coarsened tick ends at next release of critical task, so
+ *       critical tasks keep base tick and all their releases. After exitWindows consecutive quiet windows,
+ *       multiplier is halved again until normal operation is restored.
+ */
+cStatus_e Scheduler_SetOverloadControl(const SchedulerOverloadConfig_t *pConfig)
+{
+    if (NULL == pConfig)
+    {
+        gOverloadConfig.windowMs = 0;
+        gOverloadState.state = SCHEDULER_LOAD_NORMAL;
+        gOverloadState.tickMultiplier = 1;
+        gOverloadState.effectiveResolutionMs = gTimerResolutionInMilliSec;
+        return (cStatus_SUCCESS);
+    }
+
+    /* validate arguments */
+    if ((0 == pConfig->windowMs) || (0 == pConfig->enterWindows) || (0 == pConfig->exitWindows)
+            || (0 == pConfig->maxTickMultiplier) || (pConfig->highUtilizationPercent > 100)
+            || (pConfig->lowUtilizationPercent >= pConfig->highUtilizationPercent))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    gOverloadConfig = *pConfig;
+
+    /* Coarsened tick should not exceed max clock resolution */
+    if ((0 != gTimerResolutionInMilliSec) && ((gTimerResolutionInMilliSec * gOverloadConfig.maxTickMultiplier) > CLOCK_RESOLUTION_MS_MAX))
+    {
+        gOverloadConfig.maxTickMultiplier = (CLOCK_RESOLUTION_MS_MAX / gTimerResolutionInMilliSec);
+    }
+
+    gOverloadState.effectiveResolutionMs = gTimerResolutionInMilliSec * gOverloadState.tickMultiplier;
+    gOverloadWindowStartNanoSec = Clock_ReadNanoSec();
+    gOverloadBusyNanoSec = 0;
+    gOverloadMaxLateNanoSec = 0;
+    gOverloadHighWindowCnt = 0;
+    gOverloadLowWindowCnt = 0;
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gives current state of overload controller
+ * @param pState - Structure to which state will get copied
+ */
+void Scheduler_GetOverloadState(SchedulerOverloadState_t *pState)
+{
+    if (NULL == pState)
+    {
+        return;
+    }
+
+    *pState = gOverloadState;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gives timer resolution given to Scheduler_Init
+ * @return Timer resolution in millisec
+ */
+cU32_t Scheduler_GetTimerResolution(void)
+{
+    return (gTimerResolutionInMilliSec);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gives super loop statistics
+ * @param pStats - Structure to which statistics will get copied
+ */
+void Scheduler_GetLoopStats(SchedulerLoopStats_t *pStats)
+{
+    if (NULL == pStats)
+    {
+        return;
+    }
+
+    *pStats = gLoopStats;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gives identity and execution statistics of registered tasks
+ * @param pInfo - Array to which task information will get copied
+ * @param maxCnt - Size of array
+ * @return Number of tasks copied
+ */
+cU8_t Scheduler_GetTaskInfo(SchedulerTaskInfo_t *pInfo, cU8_t maxCnt)
+{
+    cU8_t taskId;
+
+    if (NULL == pInfo)
+    {
+        return (0);
+    }
+
+    for (taskId = 0; (taskId < gTaskCnt) && (taskId < maxCnt); taskId++)
+    {
+        pInfo[taskId].function = getTaskFunction(taskId);
+
+        pInfo[taskId].ctx = gTaskList[taskId].ctx;
+        pInfo[taskId].runInterval = (TimeInterval_e)gTaskList[taskId].runInterval;
+        pInfo[taskId].phaseMs = gTaskList[taskId].phaseTicks * gTimerResolutionInMilliSec;
+        pInfo[taskId].periodMs = gTaskList[taskId].clockTick.clockTicksThreshold * gTimerResolutionInMilliSec;
+        pInfo[taskId].stats = gTaskList[taskId].stats;
+    }
+
+    return (taskId);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gives wall and CPU time of registered tasks in a statistics window
+ * @param window - Window of statistics
+ * @param pUsage - Array to which task usage will get copied
+ * @param maxCnt - Size of array
+ * @return Number of tasks copied
+ * @note Usage is accounted only while loop statistics are enabled (LoopStats_Enable)
+ */
+cU8_t Scheduler_GetTaskUsage(LoopStatsWindow_e window, SchedulerTaskUsage_t *pUsage, cU8_t maxCnt)
+{
+    cU8_t taskId;
+
+    if ((NULL == pUsage) || (window >= LOOP_STATS_WINDOW_MAX))
+    {
+        return (0);
+    }
+
+    for (taskId = 0; (taskId < gTaskCnt) && (taskId < maxCnt); taskId++)
+    {
+        pUsage[taskId].function = getTaskFunction(taskId);
+
+        pUsage[taskId].ctx = gTaskList[taskId].ctx;
+        pUsage[taskId].wallNs = LoopStats_CounterGet(&gTaskList[taskId].usage.wallTime, window);
+        pUsage[taskId].cpuNs = LoopStats_CounterGet(&gTaskList[taskId].usage.cpuTime, window);
+    }
+
+    return (taskId);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that reset all timer event and saves start point
+ */
+void Scheduler_Reset(void)
+{
+    cU8_t taskId;
+
+    /* Set begin time as current time for reference to calculate dynamic sleep */
+    gBeginTime = Clock_ReadNanoSec();
+
+    /* Get the Time Since Epoch */
+    Clock_GetLocalTime(&gLastTimeRefSinceEpoch);
+
+    /* Reset Last ref monotonic time */
+    gLastMonotonicTimeInNanoSec = Clock_ReadNanoSec();
+
+    /* Member of wakeup coordinator starts from last boundary of common tick grid */
+    if (c_TRUE == SchedulerCoord_IsJoined())
+    {
+        gBeginTime = (cI64_t)SchedulerCoord_AlignNanoSec((cU64_t)gBeginTime, (cU64_t)gTimerResolutionInNanoSec);
+        gLastMonotonicTimeInNanoSec = (cU64_t)gBeginTime;
+    }
+
+    /* Reset Elapsed nano sec */
+    gElapsedNanoSec = 0;
+    gTickCnt = 0;
+
+    /* Reset all Timer Eve clock tick count */
+    for (taskId = 0; taskId < SCHEDULED_TASKS_MAX; taskId++)
+    {
+        gTaskList[taskId].clockTick.clockTicksCnt = 0;
+        gTaskList[taskId].readyToRun = c_FALSE;
+    }
+
+    /* Counters start from phase of task */
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        applyTaskPhase(taskId, gTaskList[taskId].phaseTicks);
+    }
+
+    if (SCHEDULER_STAGGER_NONE != gStaggerMode)
+    {
+        assignTaskPhases();
+    }
+
+    DPRINT("reset scheduler timer");
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gets the the time and calculate difference to generate timer events
+ */
+void Scheduler_UpdateTick(void)
+{
+    cU64_t curMonotonicTimeInNanSec = 0;
+    cU8_t taskId;
+    cU32_t timerEvents = 0;
+    cU32_t elapsedTicks = 0;
+    cU16_t releaseMask = 0;
+    cBool released;
+    struct tm curTimeStamp;
 
     /* Get Current Monotonic time in nano sec */
-    curMonotonicTimeInNanSec = Utils_GetMonotonicTimeInNanoSec();
+    curMonotonicTimeInNanSec = Clock_Snapshot();
+
+    /* Time since end of last iteration was spent in sleep */
+    if ((0 != gLoopIterEndNanoSec) && (curMonotonicTimeInNanSec > gLoopIterEndNanoSec))
+    {
+        LoopStats_AddPhaseTime(LOOP_PHASE_SLEEP, curMonotonicTimeInNanSec, curMonotonicTimeInNanSec - gLoopIterEndNanoSec);
+    }
+
+    LoopStats_PhaseBegin(LOOP_PHASE_UPDATE_TICK, curMonotonicTimeInNanSec);
+
+    /* Loop iteration starts from here for utilization measurement */
+    gLoopIterStartNanoSec = curMonotonicTimeInNanSec;
+    gLoopStats.loopIterations++;
+
+    /* Update elapsed nano seconds */
+    gElapsedNanoSec += (curMonotonicTimeInNanSec - gLastMonotonicTimeInNanoSec);
+
+    /* Now check the difference */
+    if (gElapsedNanoSec >= gTimerResolutionInNanoSec)
+    {
+        do
+        {
+            /* Decrement Elapsed time */
+            gElapsedNanoSec -= gTimerResolutionInNanoSec;
+            gTickCnt++;
+            elapsedTicks++;
+
+            /* Increment clock tick count */
+            for (taskId = 0; taskId < gTaskCnt; taskId++)
+            {
+                gTaskList[taskId].clockTick.clockTicksCnt++;
+            }
+
+        } while (gElapsedNanoSec >= gTimerResolutionInNanoSec);
+
+
+        /* Compare clock tick cnt with threshold cnt */
+        for (taskId = 0; taskId < gTaskCnt; taskId++)
+        {
+            /*
+             * As we only derive task from TimerClockTick_t structure which are having run interval less than 1 sec
+             * So, if mClockTicksThreshold is "zero" means task run interval is >= 1 sec
+             */
+            if (0 == gTaskList[taskId].clockTick.clockTicksThreshold)
+            {
+                continue;
+            }
+
+            if (gTaskList[taskId].clockTick.clockTicksCnt >= gTaskList[taskId].clockTick.clockTicksThreshold)
+            {
+                gTaskList[taskId].clockTick.clockTicksCnt -= gTaskList[taskId].clockTick.clockTicksThreshold;
+
+                /* Task released within its slack window or on coarsened tick should not run again to catch up
+                 * missed periods, critical tasks stay on base tick and keep their releases */
+                if ((0 != gTaskList[taskId].slackTicks)
+                        || ((1 < gOverloadState.tickMultiplier) && (c_TRUE == gTaskList[taskId].sheddable)))
+                {
+                    gTaskList[taskId].clockTick.clockTicksCnt %= gTaskList[taskId].clockTick.clockTicksThreshold;
+                }
+
+                /* Tasks of same interval may have different phase, so each task is released on its own */
+                releaseMask |= (cU16_t)(1U << taskId);
+            }
+        }
+
+        /* Get Time since epoch to execute task whose run interval greater/equal to 1 sec */
+        Clock_GetLocalTime(&curTimeStamp);
+
+        if (curTimeStamp.tm_sec != gLastTimeRefSinceEpoch.tm_sec)
+        {
+            /* set timer event for 1 sec */
+            timerEvents |= TIME_INTERVAL_1SEC;
+        }
+
+        if (curTimeStamp.tm_min != gLastTimeRefSinceEpoch.tm_min)
+        {
+            /* set timer event for 1 min */
+            timerEvents |= TIME_INTERVAL_1MIN;
+        }
+
+        /* save current time as reference */
+        gLastTimeRefSinceEpoch = curTimeStamp;
+    }
+
+    /** Mark all tasks ready to run */
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        released = (0 != (releaseMask & (1U << taskId))) ? c_TRUE : c_FALSE;
+
+        /* 1 sec and 1 min tasks are released phase ticks after their wall clock boundary */
+        if (0 != gTaskList[taskId].phaseWaitTicks)
+        {
+            if (gTaskList[taskId].phaseWaitTicks <= elapsedTicks)
+            {
+                gTaskList[taskId].phaseWaitTicks = 0;
+                released = c_TRUE;
+            }
+            else
+            {
+                gTaskList[taskId].phaseWaitTicks -= (cU16_t)elapsedTicks;
+            }
+        }
+
+        if (timerEvents & gTaskList[taskId].runInterval)
+        {
+            if (0 == gTaskList[taskId].phaseTicks)
+            {
+                released = c_TRUE;
+            }
+            else
+            {
+                gTaskList[taskId].phaseWaitTicks = gTaskList[taskId].phaseTicks;
+            }
+        }
+
+        if (c_TRUE == released)
+        {
+            /* Under overload, sheddable task is released only once in tick multiplier periods */
+            if ((c_TRUE == gTaskList[taskId].sheddable) && (SCHEDULER_LOAD_OVERLOADED == gOverloadState.state)
+                    && (0 != (++gTaskList[taskId].shedCnt % gOverloadState.tickMultiplier)))
+            {
+                gOverloadState.tasksShed++;
+                continue;
+            }
+
+            gTaskList[taskId].readyToRun = c_TRUE;
+            SCHEDULER_PROBE4(task__release, getTaskFunction(taskId), gTaskList[taskId].ctx, taskId,
+                             curMonotonicTimeInNanSec);
+
+            if (c_TRUE == SchedulerRecord_IsActive())
+            {
+                SchedulerRecord_Event(SCHEDULER_RECORD_TASK_RELEASE, getTaskFunction(taskId), gTaskList[taskId].ctx,
+                                      gTaskList[taskId].runInterval
+                                      | ((TaskTimer_Tick == gTaskList[taskId].callback) ? SCHEDULER_RECORD_TIMER_TICK : 0),
+                                      curMonotonicTimeInNanSec);
+            }
+        }
+    }
+
+    /* save current time as reference */
+    gLastMonotonicTimeInNanoSec = curMonotonicTimeInNanSec;
+
+    if (0 != (LoopStats_GetEnabled() & LOOP_STATS_PHASES))
+    {
+        LoopStats_PhaseEnd(Clock_ReadNanoSec());
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that calculates the dynamic sleep time
+ * @return Sleep time in nanoseconds
+ */
+cI64_t Scheduler_GetDynamicSleep(void)
+{
+    static cI64_t diffNs;
+    static cU64_t endTime;
+    cU32_t sleepTicks = 1;
+    cU32_t coarseTicks;
+
+    if (c_TRUE == gWakeupCoalescingF)
+    {
+        /* Skip the ticks on which no task is due */
+        sleepTicks = getCoalescedSleepTicks();
+    }
+
+    /* Overload controller may have coarsened the tick, but not beyond next release of critical task */
+    if (sleepTicks < gOverloadState.tickMultiplier)
+    {
+        coarseTicks = getCriticalDueTicks();
+        if (coarseTicks > gOverloadState.tickMultiplier)
+        {
+            coarseTicks = gOverloadState.tickMultiplier;
+        }
+
+        if (coarseTicks > sleepTicks)
+        {
+            sleepTicks = coarseTicks;
+        }
+    }
+
+    /* Add the nanoseconds of timer tick resolution to derive the Sleep */
+    gBeginTime += (gTimerResolutionInNanoSec * sleepTicks);
+
+    /* get current time */
+    endTime = Clock_ReadNanoSec();
+    gLoopIterEndNanoSec = endTime;
+
+    /* Get the Difference */
+    diffNs = gBeginTime - endTime;
+
+    updateOverloadController(endTime, -diffNs);
+
+    if (diffNs > 0)
+    {
+        gLoopStats.lastLatenessNs = 0;
+        return (diffNs);
+    }
+
+    gLoopStats.lateIterations++;
+    gLoopStats.lastLatenessNs = (cU64_t)(-diffNs);
+    if (gLoopStats.lastLatenessNs > gLoopStats.maxLatenessNs)
+    {
+        gLoopStats.maxLatenessNs = gLoopStats.lastLatenessNs;
+    }
+
+    SCHEDULER_PROBE2(loop__late, gLoopStats.lastLatenessNs, gLoopStats.lateIterations);
+
+    /* Under overload do not try to catch up missed ticks, restart timeline from now */
+    if (SCHEDULER_LOAD_OVERLOADED == gOverloadState.state)
+    {
+        gBeginTime = (cI64_t)SchedulerCoord_AlignNanoSec(endTime, (cU64_t)gTimerResolutionInNanoSec);
+    }
+
+    /* convert into positive */
+    diffNs = ((-diffNs) / NANO_SECONDS_PER_MILLI_SECOND);
+
+    /* Add warning only if we're delayed by minimum heart-beat interval */
+    if (diffNs > gMaxPermittedDelayMilliSec)
+    {
+        WPRINT("we are running late by [%d]ms", (cI32_t)diffNs);
+    }
+
+    /* If we are running late by few ms then we will not sleep for 10 ms but only for 1 ms &
+     * execute the tasks again. Without this 1 ms sleep, CPU usage may go around 100%. */
+    return (BASE_SLEEP_TIME_IN_NS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function run all tasks that are ready to run
+ */
+void Scheduler_ExecuteTasksReadyToRun(void)
+{
+    cU8_t taskId;
+    cU16_t releasedMask = 0;
+    cU16_t dependencyMask = 0;
+    cU16_t parallelMask = 0;
+    cU32_t loopStatsFlags = LoopStats_GetEnabled();
+
+    tLoopThreadF = c_TRUE;
+
+    /* Tasks registered before watchdog was started get their slots once */
+    if (gWatchdogStartCnt != SchedulerWatchdog_GetStartCount())
+    {
+        resolveTaskWatchdogSlots();
+    }
+
+    if (0 != (loopStatsFlags & LOOP_STATS_PHASES))
+    {
+        LoopStats_PhaseBegin(LOOP_PHASE_DISPATCH, Clock_ReadNanoSec());
+    }
+
+    /* Tasks registered by callbacks are appended after dispatched tasks and get released from next tick,
+     * deregistered tasks are only marked till end of pass */
+    gDispatchingF = c_TRUE;
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        /* Async body is handed to executor here and takes no part in dependency order */
+        if ((c_TRUE == gTaskList[taskId].readyToRun) && (NULL != gTaskList[taskId].asyncCompletion))
+        {
+            gTaskList[taskId].readyToRun = c_FALSE;
+            releaseAsyncTask(taskId);
+        }
+        else if (c_TRUE == gTaskList[taskId].readyToRun)
+        {
+            releasedMask |= (cU16_t)(1U << taskId);
+            dependencyMask |= gTaskList[taskId].dependsOnMask;
+            if (c_TRUE == gTaskList[taskId].parallelSafe)
+            {
+                parallelMask |= (cU16_t)(1U << taskId);
+            }
+        }
+    }
+
+    /* Workers are woken only when a parallel safe task has another task of the release to overlap with */
+    if ((0 != (dependencyMask & releasedMask))
+            || ((0 != parallelMask) && (0 != (releasedMask & (releasedMask - 1U))) && (0 != WorkerPool_GetThreadCount())))
+    {
+        executeTaskGraph(releasedMask, loopStatsFlags);
+    }
+    else
+    {
+        for (taskId = 0; taskId < gTaskCnt; taskId++)
+        {
+            if (c_TRUE == gTaskList[taskId].readyToRun)
+            {
+                gTaskList[taskId].readyToRun = c_FALSE;
+                runTask(taskId, loopStatsFlags);
+            }
+        }
+    }
+
+    gDispatchingF = c_FALSE;
+    removeTaskTombstones();
+
+    runAsyncCompletions();
+    runDeferredJobs();
+
+    if (0 != (loopStatsFlags & LOOP_STATS_PHASES))
+    {
+        LoopStats_PhaseEnd(Clock_ReadNanoSec());
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that adds task in the first free location of list
+ * @param (*callback) - Address of function without context, NULL if task takes context
+ * @param (*ctxCallback) - Address of function with context, NULL if task does not take context
+ * @param ctx - Application context passed to ctxCallback
+ * @param runInterval - Interval for execution of task
+ * @return Error code to indicate success or failure of function
+ */
+static cStatus_e registerTask(void (*callback)(void), void (*ctxCallback)(void *ctx), void *ctx, TimeInterval_e runInterval)
+{
+    cBool isRegistered = c_FALSE;
+    cU8_t taskId;
+
+    /* Check if max tasks are already registered */
+    if (gTaskCnt >= SCHEDULED_TASKS_MAX)
+    {
+        return (cStatus_NO_RESOURCE);
+    }
+
+    if (findTask(callback, ctxCallback, ctx) >= 0)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    for (taskId = 0; taskId < SCHEDULED_TASKS_MAX; taskId++)
+    {
+        if (c_FALSE == isTaskSlotFree(&gTaskList[taskId]))
+        {
+            continue;
+        }
+
+        resetTaskEntry(&gTaskList[taskId]);
+        gTaskList[taskId].callback = callback;
+        gTaskList[taskId].ctxCallback = ctxCallback;
+        gTaskList[taskId].ctx = ctx;
+        gTaskList[taskId].runInterval = runInterval;
+        gTaskList[taskId].watchdogSlot = SchedulerWatchdog_AcquireSlot(getTaskFunction(taskId), ctx);
+        isRegistered = c_TRUE;
+
+        switch (runInterval)
+        {
+            case TIME_INTERVAL_10MS:
+                gTaskList[taskId].clockTick.clockTicksThreshold = (10 / gTimerResolutionInMilliSec);
+                break;
+
+            case TIME_INTERVAL_20MS:
+                gTaskList[taskId].clockTick.clockTicksThreshold = (20 / gTimerResolutionInMilliSec);
+                break;
+
+            case TIME_INTERVAL_100MS:
+                gTaskList[taskId].clockTick.clockTicksThreshold = (100 / gTimerResolutionInMilliSec);
+                break;
+
+            default:
+                /* we are not using TimerClockTick_t structure for tasks having run interval of more than 1 sec */
+                break;
+        }
+
+        /* Increase Tasks cnt */
+        gTaskCnt++;
+
+        if (SCHEDULER_STAGGER_NONE != gStaggerMode)
+        {
+            assignNewTaskPhase(taskId);
+        }
+        break;
+    }
+
+    if (c_FALSE == isRegistered)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that removes task from list
+ * @param (*callback) - Address of function without context, NULL if task takes context
+ * @param (*ctxCallback) - Address of function with context, NULL if task does not take context
+ * @param ctx - Application context given at the time of registration
+ * @return Error code to indicate success or failure of function
+ * @note Task is looked up by a scan of the list, marking it is O(1). List holds at most
+ *       SCHEDULED_TASKS_MAX tasks (16 at most by dependency masks), so lookup and removal are O(N)
+ *       with small N rather than O(1)
+ */
+static cStatus_e deregisterTask(void (*callback)(void), void (*ctxCallback)(void *ctx), void *ctx)
+{
+    cU8_t taskId;
+
+    /* If no tasks are registered, we can't deregister */
+    if (0 == gTaskCnt)
+    {
+        return (cStatus_SUCCESS);
+    }
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        if ((callback != gTaskList[taskId].callback) || (ctxCallback != gTaskList[taskId].ctxCallback)
+                || ((NULL != ctxCallback) && (ctx != gTaskList[taskId].ctx)))
+        {
+            continue;
+        }
+
+        /* Entry stays in place while tasks are dispatched, only its release is cancelled */
+        gTaskList[taskId].readyToRun = c_FALSE;
+        gTaskTombstoneMask |= (cU16_t)(1U << taskId);
+    }
+
+    if (c_FALSE == gDispatchingF)
+    {
+        removeTaskTombstones();
+    }
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets slack of task
+ * @param taskId - Index of task in the list, negative if task is not registered
+ * @param slackMs - Tolerated release delay in millisec (rounded down to timer resolution)
+ * @return Error code to indicate success or failure of function
+ */
+static cStatus_e setTaskSlack(cI16_t taskId, cU32_t slackMs)
+{
+    cU32_t slackTicks;
+
+    if (0 == gTimerResolutionInMilliSec)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (taskId < 0)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    slackTicks = (slackMs / gTimerResolutionInMilliSec);
+    if (slackTicks > UINT16_MAX)
+    {
+        slackTicks = UINT16_MAX;
+    }
+
+    gTaskList[taskId].slackTicks = (cU16_t)slackTicks;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets whether task may be shed under overload
+ * @param taskId - Index of task in the list, negative if task is not registered
+ * @param sheddable - true if task may be shed
+ * @return Error code to indicate success or failure of function
+ */
+static cStatus_e setTaskSheddable(cI16_t taskId, cBool sheddable)
+{
+    if (taskId < 0)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    gTaskList[taskId].sheddable = sheddable;
+    gTaskList[taskId].shedCnt = 0;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets whether task may run on worker thread
+ * @param taskId - Index of task in the list, negative if task is not registered
+ * @param parallelSafe - true if task may run on worker thread
+ * @return Error code to indicate success or failure of function
+ */
+static cStatus_e setTaskParallelSafe(cI16_t taskId, cBool parallelSafe)
+{
+    if (taskId < 0)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    /* Async task body runs on executor thread anyway */
+    if (NULL != gTaskList[taskId].asyncCompletion)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    gTaskList[taskId].parallelSafe = parallelSafe;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that changes period of task
+ * @param taskId - Index of task in the list, negative if task is not registered
+ * @param periodMs - New period in millisec
+ * @return Error code to indicate success or failure of function
+ */
+static cStatus_e setTaskPeriod(cI16_t taskId, cU32_t periodMs)
+{
+    cU32_t periodTicks;
+
+    if ((0 == gTimerResolutionInMilliSec) || (0 == periodMs) || (0 != (periodMs % gTimerResolutionInMilliSec)))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    periodTicks = periodMs / gTimerResolutionInMilliSec;
+    if (periodTicks > UINT16_MAX)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (taskId < 0)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    /* Run interval stays meaningful for statistics only when it matches the period */
+    switch (periodMs)
+    {
+        case 10:
+            gTaskList[taskId].runInterval = TIME_INTERVAL_10MS;
+            break;
+
+        case 20:
+            gTaskList[taskId].runInterval = TIME_INTERVAL_20MS;
+            break;
+
+        case 100:
+            gTaskList[taskId].runInterval = TIME_INTERVAL_100MS;
+            break;
+
+        default:
+            gTaskList[taskId].runInterval = TIME_INTERVAL_NONE;
+            break;
+    }
+
+    changeTaskPeriodTicks((cU8_t)taskId, (cU16_t)periodTicks);
+
+    /* Adaptive task backs off from its new period */
+    if (0 != gTaskList[taskId].maxPeriodTicks)
+    {
+        gTaskList[taskId].basePeriodTicks = (cU16_t)periodTicks;
+        if (gTaskList[taskId].maxPeriodTicks < periodTicks)
+        {
+            gTaskList[taskId].maxPeriodTicks = (cU16_t)periodTicks;
+        }
+    }
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets longest period of adaptive task
+ * @param taskId - Index of task in the list, negative if task is not registered
+ * @param maxPeriodMs - Longest period in millisec, 0 to disable backoff
+ * @return Error code to indicate success or failure of function
+ */
+static cStatus_e setTaskBackoff(cI16_t taskId, cU32_t maxPeriodMs)
+{
+    cU32_t maxPeriodTicks;
+
+    if ((0 == gTimerResolutionInMilliSec) || (0 != (maxPeriodMs % gTimerResolutionInMilliSec)))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    maxPeriodTicks = maxPeriodMs / gTimerResolutionInMilliSec;
+    if (maxPeriodTicks > UINT16_MAX)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (taskId < 0)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    if (0 == maxPeriodTicks)
+    {
+        if (0 != gTaskList[taskId].maxPeriodTicks)
+        {
+            changeTaskPeriodTicks((cU8_t)taskId, gTaskList[taskId].basePeriodTicks);
+        }
+
+        gTaskList[taskId].basePeriodTicks = 0;
+        gTaskList[taskId].maxPeriodTicks = 0;
+        return (cStatus_SUCCESS);
+    }
+
+    /* Task released on wall clock boundary has no tick period to back off from */
+    if (0 == gTaskList[taskId].clockTick.clockTicksThreshold)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    if (0 == gTaskList[taskId].maxPeriodTicks)
+    {
+        gTaskList[taskId].basePeriodTicks = gTaskList[taskId].clockTick.clockTicksThreshold;
+    }
+
+    if (maxPeriodTicks < gTaskList[taskId].basePeriodTicks)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    gTaskList[taskId].maxPeriodTicks = (cU16_t)maxPeriodTicks;
+    gTaskList[taskId].workReport = WORK_REPORT_NONE;
+
+    if (gTaskList[taskId].clockTick.clockTicksThreshold > maxPeriodTicks)
+    {
+        changeTaskPeriodTicks((cU8_t)taskId, (cU16_t)maxPeriodTicks);
+    }
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that changes tick period of task keeping ticks elapsed since its last release
+ * @param taskId - Index of task
+ * @param periodTicks - New period in ticks
+ */
+static void changeTaskPeriodTicks(cU8_t taskId, cU16_t periodTicks)
+{
+    TimerClockTick_t *pClockTick = &gTaskList[taskId].clockTick;
+
+    if (0 == pClockTick->clockTicksThreshold)
+    {
+        /* Tick counter of 1 sec and 1 min task is not maintained, count from now */
+        pClockTick->clockTicksCnt = 0;
+        gTaskList[taskId].phaseWaitTicks = 0;
+    }
+    else if (pClockTick->clockTicksCnt >= periodTicks)
+    {
+        /* New period has already passed since last release, release once on next tick */
+        pClockTick->clockTicksCnt = periodTicks - 1U;
+    }
+
+    pClockTick->clockTicksThreshold = periodTicks;
+
+    /* Phase is kept without offset of wakeup coordinator, it is added again when phase is applied */
+    gTaskList[taskId].phaseTicks = (cU16_t)((gTickCnt + (2U * periodTicks) - pClockTick->clockTicksCnt
+                                             - getTaskStaggerTicks(taskId, periodTicks)) % periodTicks);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that adjusts period of adaptive task by work reported from its run
+ * @param taskId - Index of task
+ */
+static void applyWorkReport(cU8_t taskId)
+{
+    cU32_t periodTicks = gTaskList[taskId].clockTick.clockTicksThreshold;
+    cU8_t workReport = gTaskList[taskId].workReport;
+
+    gTaskList[taskId].workReport = WORK_REPORT_NONE;
+
+    if ((0 == gTaskList[taskId].maxPeriodTicks) || (0 == periodTicks))
+    {
+        return;
+    }
+
+    if (WORK_REPORT_FOUND == workReport)
+    {
+        periodTicks = gTaskList[taskId].basePeriodTicks;
+    }
+    else if (WORK_REPORT_IDLE == workReport)
+    {
+        periodTicks = periodTicks * 2;
+        if (periodTicks > gTaskList[taskId].maxPeriodTicks)
+        {
+            periodTicks = gTaskList[taskId].maxPeriodTicks;
+        }
+    }
+
+    if (periodTicks != gTaskList[taskId].clockTick.clockTicksThreshold)
+    {
+        changeTaskPeriodTicks(taskId, (cU16_t)periodTicks);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that sets release offset of task
+ * @param taskId - Index of task in the list, negative if task is not registered
+ * @param phaseMs - Offset in millisec, SCHEDULER_PHASE_AUTO for automatic assignment
+ * @return Error code to indicate success or failure of function
+ */
+static cStatus_e setTaskPhase(cI16_t taskId, cU32_t phaseMs)
+{
+    cU32_t phaseTicks;
+
+    if (0 == gTimerResolutionInMilliSec)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (taskId < 0)
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    if (SCHEDULER_PHASE_AUTO == phaseMs)
+    {
+        gTaskList[taskId].phaseExplicit = c_FALSE;
+        assignNewTaskPhase((cU8_t)taskId);
+        return (cStatus_SUCCESS);
+    }
+
+    phaseTicks = (phaseMs / gTimerResolutionInMilliSec);
+    if (phaseTicks >= getTaskPeriodTicks((cU8_t)taskId))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    gTaskList[taskId].phaseExplicit = c_TRUE;
+    applyTaskPhase((cU8_t)taskId, (cU16_t)phaseTicks);
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function gives number of ticks over which phase of task can be spread
+ * @param taskId - Index of task
+ * @return Interval of task in ticks, one second for 1 sec and 1 min tasks, 0 if task is never released
+ */
+static cU32_t getTaskPeriodTicks(cU8_t taskId)
+{
+    if (0 != gTaskList[taskId].clockTick.clockTicksThreshold)
+    {
+        return (gTaskList[taskId].clockTick.clockTicksThreshold);
+    }
+
+    if ((TIME_INTERVAL_1SEC == gTaskList[taskId].runInterval) || (TIME_INTERVAL_1MIN == gTaskList[taskId].runInterval))
+    {
+        return (CLOCK_RESOLUTION_MS_MAX / gTimerResolutionInMilliSec);
+    }
+
+    return (0);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function gives load which task adds on tick of its release
+ * @param taskId - Index of task
+ * @return Average run time in nanosec in balanced mode, otherwise 1
+ */
+static cU64_t getTaskPhaseCost(cU8_t taskId)
+{
+    if ((SCHEDULER_STAGGER_BALANCED != gStaggerMode) || (0 == gTaskList[taskId].stats.runCnt))
+    {
+        return (1);
+    }
+
+    return (gTaskList[taskId].stats.totalRunNs / gTaskList[taskId].stats.runCnt) + 1;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function adds load of task on every tick of one second on which it is released
+ * @param taskId - Index of task
+ */
+static void addTaskPhaseLoad(cU8_t taskId)
+{
+    cU32_t windowTicks = (CLOCK_RESOLUTION_MS_MAX / gTimerResolutionInMilliSec);
+    cU32_t periodTicks = getTaskPeriodTicks(taskId);
+    cU64_t cost = getTaskPhaseCost(taskId);
+    cU32_t tick;
+
+    if (0 == periodTicks)
+    {
+        return;
+    }
+
+    for (tick = gTaskList[taskId].phaseTicks; tick < windowTicks; tick += periodTicks)
+    {
+        gPhaseLoad[tick] += cost;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function finds phase of task on which the busiest of its release ticks is least loaded
+ * @param taskId - Index of task
+ * @return Phase in ticks
+ */
+static cU16_t pickTaskPhase(cU8_t taskId)
+{
+    cU32_t windowTicks = (CLOCK_RESOLUTION_MS_MAX / gTimerResolutionInMilliSec);
+    cU32_t periodTicks = getTaskPeriodTicks(taskId);
+    cU32_t phase;
+    cU32_t tick;
+    cU16_t bestPhase = 0;
+    cU64_t peakLoad;
+    cU64_t totalLoad;
+    cU64_t bestPeakLoad = UINT64_MAX;
+    cU64_t bestTotalLoad = UINT64_MAX;
+
+    for (phase = 0; (phase < periodTicks) && (phase < windowTicks); phase++)
+    {
+        peakLoad = 0;
+        totalLoad = 0;
+
+        for (tick = phase; tick < windowTicks; tick += periodTicks)
+        {
+            totalLoad += gPhaseLoad[tick];
+            if (gPhaseLoad[tick] > peakLoad)
+            {
+                peakLoad = gPhaseLoad[tick];
+            }
+        }
+
+        /* Lowest peak wins, then lowest total load, then earliest phase */
+        if ((peakLoad < bestPeakLoad) || ((peakLoad == bestPeakLoad) && (totalLoad < bestTotalLoad)))
+        {
+            bestPeakLoad = peakLoad;
+            bestTotalLoad = totalLoad;
+            bestPhase = (cU16_t)phase;
+        }
+    }
+
+    return (bestPhase);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function sets phase of task and aligns its tick counter on it
+ * @param taskId - Index of task
+ * @param phaseTicks - Phase in ticks, less than interval of task
+ * @note Task is released on ticks where (ticks since reset % interval) equals phase
+ */
+static void applyTaskPhase(cU8_t taskId, cU16_t phaseTicks)
+{
+    cU32_t periodTicks = gTaskList[taskId].clockTick.clockTicksThreshold;
+    cU32_t dueTicks;
+
+    gTaskList[taskId].phaseTicks = phaseTicks;
+    gTaskList[taskId].phaseWaitTicks = 0;
+
+    /* 1 sec and 1 min tasks count their phase from wall clock boundary */
+    if (0 == periodTicks)
+    {
+        return;
+    }
+
+    /* Member of wakeup coordinator is shifted against other members */
+    phaseTicks = (cU16_t)((phaseTicks + getTaskStaggerTicks(taskId, periodTicks)) % periodTicks);
+    dueTicks = (cU32_t)((phaseTicks + periodTicks - (gTickCnt % periodTicks)) % periodTicks);
+    gTaskList[taskId].clockTick.clockTicksCnt = (0 == dueTicks) ? 0 : (periodTicks - dueTicks);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function assigns phase of every task which does not have explicit phase
+ * @note Explicit phases are loaded first, then remaining tasks take least loaded phase in order of
+ *       decreasing cost (longest processing time first)
+ */
+static void assignTaskPhases(void)
+{
+    cU8_t taskId;
+    cU8_t orderIdx;
+    cU8_t autoCnt = 0;
+    cU8_t order[SCHEDULED_TASKS_MAX];
+
+    memset(gPhaseLoad, 0, sizeof(gPhaseLoad));
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        if (c_TRUE == gTaskList[taskId].phaseExplicit)
+        {
+            addTaskPhaseLoad(taskId);
+            continue;
+        }
+
+        if (SCHEDULER_STAGGER_NONE == gStaggerMode)
+        {
+            applyTaskPhase(taskId, 0);
+            continue;
+        }
+
+        /* Insert by decreasing cost, equal cost keeps list order */
+        for (orderIdx = autoCnt; (orderIdx > 0) && (getTaskPhaseCost(order[orderIdx - 1]) < getTaskPhaseCost(taskId)); orderIdx--)
+        {
+            order[orderIdx] = order[orderIdx - 1];
+        }
+
+        order[orderIdx] = taskId;
+        autoCnt++;
+    }
+
+    for (orderIdx = 0; orderIdx < autoCnt; orderIdx++)
+    {
+        applyTaskPhase(order[orderIdx], pickTaskPhase(order[orderIdx]));
+        addTaskPhaseLoad(order[orderIdx]);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function assigns least loaded phase to one task, phases of other tasks are kept
+ * @param taskId - Index of task
+ */
+static void assignNewTaskPhase(cU8_t taskId)
+{
+    cU8_t otherId;
+
+    if (SCHEDULER_STAGGER_NONE == gStaggerMode)
+    {
+        applyTaskPhase(taskId, 0);
+        return;
+    }
+
+    memset(gPhaseLoad, 0, sizeof(gPhaseLoad));
+
+    for (otherId = 0; otherId < gTaskCnt; otherId++)
+    {
+        if (otherId != taskId)
+        {
+            addTaskPhaseLoad(otherId);
+        }
+    }
+
+    applyTaskPhase(taskId, pickTaskPhase(taskId));
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that measures loop utilization and lateness and adapts tick multiplier
+ * @param curTimeNs - Current monotonic time in nanosec (end of busy part of loop iteration)
+ * @param lateNs - How late super loop is against its ideal timeline, negative if it is early
+ */
+static void updateOverloadController(cU64_t curTimeNs, cI64_t lateNs)
+{
+    cU64_t windowNs;
+    cU32_t maxLateMs;
+    cBool isOverloaded;
+
+    if (0 == gOverloadConfig.windowMs)
+    {
+        return;
+    }
+
+    if (curTimeNs > gLoopIterStartNanoSec)
+    {
+        gOverloadBusyNanoSec += (curTimeNs - gLoopIterStartNanoSec);
+    }
+
+    if (lateNs > gOverloadMaxLateNanoSec)
+    {
+        gOverloadMaxLateNanoSec = lateNs;
+    }
+
+    windowNs = curTimeNs - gOverloadWindowStartNanoSec;
+    if (windowNs < ((cU64_t)gOverloadConfig.windowMs * NANO_SECONDS_PER_MILLI_SECOND))
+    {
+        return;
+    }
 
-    /* Update elapsed nano seconds */
-    gElapsedNanoSec += (curMonotonicTimeInNanSec - gLastMonotonicTimeInNanoSec);
+    /* Window completed, evaluate it */
+    maxLateMs = (cU32_t)(gOverloadMaxLateNanoSec / NANO_SECONDS_PER_MILLI_SECOND);
+    gOverloadState.utilizationPercent = (cU32_t)((gOverloadBusyNanoSec * 100) / windowNs);
+    gOverloadState.maxLatenessMs = maxLateMs;
+
+    isOverloaded = ((gOverloadState.utilizationPercent >= gOverloadConfig.highUtilizationPercent)
+                    || ((0 != gOverloadConfig.maxLatenessMs) && (maxLateMs >= gOverloadConfig.maxLatenessMs)));
+
+    if (c_TRUE == isOverloaded)
+    {
+        gOverloadLowWindowCnt = 0;
+        if ((++gOverloadHighWindowCnt >= gOverloadConfig.enterWindows)
+                && (gOverloadState.tickMultiplier < gOverloadConfig.maxTickMultiplier))
+        {
+            gOverloadHighWindowCnt = 0;
+            gOverloadState.tickMultiplier <<= 1;
+            if (gOverloadState.tickMultiplier > gOverloadConfig.maxTickMultiplier)
+            {
+                gOverloadState.tickMultiplier = gOverloadConfig.maxTickMultiplier;
+            }
+
+            if (SCHEDULER_LOAD_NORMAL == gOverloadState.state)
+            {
+                gOverloadState.state = SCHEDULER_LOAD_OVERLOADED;
+                gOverloadState.overloadEntries++;
+            }
+
+            WPRINT("super loop overloaded: [utilization=%u%%], [late=%ums], [tickMultiplier=%u]",
+                   gOverloadState.utilizationPercent, maxLateMs, gOverloadState.tickMultiplier);
+        }
+    }
+    else if ((gOverloadState.utilizationPercent <= gOverloadConfig.lowUtilizationPercent)
+             && (gOverloadState.tickMultiplier > 1))
+    {
+        gOverloadHighWindowCnt = 0;
+        if (++gOverloadLowWindowCnt >= gOverloadConfig.exitWindows)
+        {
+            gOverloadLowWindowCnt = 0;
+            gOverloadState.tickMultiplier >>= 1;
+            if (1 >= gOverloadState.tickMultiplier)
+            {
+                gOverloadState.tickMultiplier = 1;
+                gOverloadState.state = SCHEDULER_LOAD_NORMAL;
+                IPRINT("super loop load recovered: [utilization=%u%%]", gOverloadState.utilizationPercent);
+            }
+        }
+    }
+    else
+    {
+        gOverloadHighWindowCnt = 0;
+        gOverloadLowWindowCnt = 0;
+    }
+
+    gOverloadState.effectiveResolutionMs = gTimerResolutionInMilliSec * gOverloadState.tickMultiplier;
+
+    /* Start next window */
+    gOverloadWindowStartNanoSec = curTimeNs;
+    gOverloadBusyNanoSec = 0;
+    gOverloadMaxLateNanoSec = 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function finds registered task in the list
+ * @param (*callback) - Address of function without context, NULL if task takes context
+ * @param (*ctxCallback) - Address of function with context, NULL if task does not take context
+ * @param ctx - Application context given at the time of registration
+ * @return Index of task in the list, -1 if not found
+ */
+static cI16_t findTask(void (*callback)(void), void (*ctxCallback)(void *ctx), void *ctx)
+{
+    cU8_t taskId;
+
+    for (taskId = 0; taskId < gTaskCnt ; taskId++)
+    {
+        /* Task deregistered in this dispatch pass is gone, it can be registered again */
+        if (0 != (gTaskTombstoneMask & (1U << taskId)))
+        {
+            continue;
+        }
+
+        if (NULL != callback)
+        {
+            if (callback == gTaskList[taskId].callback)
+            {
+                return (taskId);
+            }
+        }
+        else if ((ctxCallback == gTaskList[taskId].ctxCallback) && (ctx == gTaskList[taskId].ctx))
+        {
+            return (taskId);
+        }
+    }
+
+    return (-1);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function checks if location in the task list is free
+ * @param pTask - Task list entry
+ * @return true if no task is registered at this location, false otherwise
+ */
+static cBool isTaskSlotFree(const ScheduleTask_t *pTask)
+{
+    return ((NULL == pTask->callback) && (NULL == pTask->ctxCallback)) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function clears task list entry
+ * @param pTask - Task list entry
+ */
+static void resetTaskEntry(ScheduleTask_t *pTask)
+{
+    pTask->readyToRun = c_FALSE;
+    pTask->runInterval = TIME_INTERVAL_NONE;
+    pTask->callback = NULL;
+    pTask->ctxCallback = NULL;
+    pTask->ctx = NULL;
+    pTask->clockTick.clockTicksCnt = 0;
+    pTask->clockTick.clockTicksThreshold = 0;
+    pTask->slackTicks = 0;
+    pTask->sheddable = c_FALSE;
+    pTask->parallelSafe = c_FALSE;
+    pTask->watchdogSlot = SCHEDULER_WATCHDOG_SLOT_NONE;
+    pTask->shedCnt = 0;
+    pTask->stats.runCnt = 0;
+    pTask->stats.lastRunNs = 0;
+    pTask->stats.maxRunNs = 0;
+    pTask->stats.totalRunNs = 0;
+    memset(&pTask->usage, 0, sizeof(pTask->usage));
+    pTask->dependsOnMask = 0;
+    pTask->phaseTicks = 0;
+    pTask->phaseWaitTicks = 0;
+    pTask->phaseExplicit = c_FALSE;
+    pTask->asyncCompletion = NULL;
+    pTask->asyncPolicy = SCHEDULER_ASYNC_SKIP;
+    pTask->asyncState = ASYNC_STATE_IDLE;
+    pTask->workReport = WORK_REPORT_NONE;
+    pTask->basePeriodTicks = 0;
+    pTask->maxPeriodTicks = 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function derives number of ticks to sleep so that deadlines which fall into each other's
+ *        slack window are served by single wakeup
+ * @return Number of timer ticks to sleep (at least 1)
+ * @note Wakeup is placed on the earliest "deadline + slack" of all tasks, and every task whose deadline
+ *       is on or before that tick gets released on the same wakeup.
+ */
+static cU32_t getCoalescedSleepTicks(void)
+{
+    cU8_t taskId;
+    cU8_t dueIdx;
+    cU8_t distinctCnt = 0;
+    cU32_t dueTicks[SCHEDULED_TASKS_MAX];
+    cU32_t distinctTicks[SCHEDULED_TASKS_MAX];
+    cU32_t latestTicks;
+
+    /* We never sleep more than max clock resolution even if there is nothing to do */
+    cU32_t wakeupTicks = (CLOCK_RESOLUTION_MS_MAX / gTimerResolutionInMilliSec);
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        dueTicks[taskId] = getTaskDueTicks(taskId);
+        if (UINT32_MAX == dueTicks[taskId])
+        {
+            continue;
+        }
+
+        latestTicks = dueTicks[taskId] + gTaskList[taskId].slackTicks;
+        if (latestTicks < wakeupTicks)
+        {
+            wakeupTicks = latestTicks;
+        }
+    }
+
+    /* Deferred jobs must not wait beyond their due tick */
+    latestTicks = getTicksToNextJob();
+    if (latestTicks < wakeupTicks)
+    {
+        wakeupTicks = latestTicks;
+    }
+
+    /* Count distinct deadlines served by this wakeup */
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        if (dueTicks[taskId] > wakeupTicks)
+        {
+            continue;
+        }
+
+        for (dueIdx = 0; dueIdx < distinctCnt; dueIdx++)
+        {
+            if (distinctTicks[dueIdx] == dueTicks[taskId])
+            {
+                break;
+            }
+        }
+
+        if (dueIdx == distinctCnt)
+        {
+            distinctTicks[distinctCnt++] = dueTicks[taskId];
+        }
+    }
+
+    gWakeupStats.wakeups++;
+    if (distinctCnt > 1)
+    {
+        gWakeupStats.deadlinesCoalesced += (distinctCnt - 1);
+    }
+    else
+    {
+        /* Wakeup without any deadline still counts as one tick on which we woke up */
+        distinctCnt = 1;
+    }
+
+    /* Per tick wakeup would have woken up on every tick till planned wakeup */
+    gWakeupStats.idleTicksSkipped += (wakeupTicks - distinctCnt);
+
+    return (wakeupTicks);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function gives number of ticks till next release of task
+ * @param taskId - Index of task
+ * @return Ticks till release (1 if task is due on next tick), UINT32_MAX if task is never released
+ */
+static cU32_t getTaskDueTicks(cU8_t taskId)
+{
+    if (0 != gTaskList[taskId].clockTick.clockTicksThreshold)
+    {
+        if (gTaskList[taskId].clockTick.clockTicksCnt >= gTaskList[taskId].clockTick.clockTicksThreshold)
+        {
+            return (1);
+        }
+
+        return (gTaskList[taskId].clockTick.clockTicksThreshold - gTaskList[taskId].clockTick.clockTicksCnt);
+    }
+
+    /* Wall clock boundary has passed, task waits for its phase */
+    if (0 != gTaskList[taskId].phaseWaitTicks)
+    {
+        return (gTaskList[taskId].phaseWaitTicks);
+    }
+
+    if (TIME_INTERVAL_1SEC == gTaskList[taskId].runInterval)
+    {
+        return (getTicksToWallClockBoundary(NANO_SECONDS_PER_SECOND) + gTaskList[taskId].phaseTicks);
+    }
+
+    if (TIME_INTERVAL_1MIN == gTaskList[taskId].runInterval)
+    {
+        return (getTicksToWallClockBoundary(NANO_SECONDS_PER_MINUTE) + gTaskList[taskId].phaseTicks);
+    }
+
+    return (UINT32_MAX);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function gives number of ticks till latest wakeup which serves critical (not sheddable)
+ *        tasks and deferred jobs on time, coarsened tick of overload controller never sleeps beyond it
+ * @return Number of timer ticks (at least 1)
+ */
+static cU32_t getCriticalDueTicks(void)
+{
+    cU8_t taskId;
+    cU32_t dueTicks;
+    cU32_t criticalTicks = getTicksToNextJob();
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        if (c_TRUE == gTaskList[taskId].sheddable)
+        {
+            continue;
+        }
+
+        dueTicks = getTaskDueTicks(taskId);
+        if ((UINT32_MAX != dueTicks) && ((dueTicks + gTaskList[taskId].slackTicks) < criticalTicks))
+        {
+            criticalTicks = dueTicks + gTaskList[taskId].slackTicks;
+        }
+    }
+
+    return (0 != criticalTicks) ? criticalTicks : 1;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function derives number of ticks until next wall clock boundary
+ * @param boundaryNs - Wall clock boundary (1 sec or 1 min) in nanosec
+ * @return Number of timer ticks until boundary (at least 1)
+ */
+static cU32_t getTicksToWallClockBoundary(cI64_t boundaryNs)
+{
+    cI64_t remainingNs = boundaryNs - (cI64_t)(Clock_GetRealTimeNanoSec() % (cU64_t)boundaryNs);
+    cI64_t ticks = ((remainingNs + gTimerResolutionInNanoSec - 1) / gTimerResolutionInNanoSec);
+
+    return ((ticks > 0) ? (cU32_t)ticks : 1);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function adds dependency edge between two tasks
+ * @param beforeId - Index of task which runs first
+ * @param afterId - Index of task which waits for before task
+ * @return Error code to indicate success or failure of function
+ */
+static cStatus_e addTaskDependency(cI16_t beforeId, cI16_t afterId)
+{
+    cU16_t visitedMask = 0;
+    cU16_t pendingMask;
+    cU8_t taskId;
+
+    if ((beforeId < 0) || (afterId < 0))
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    if (beforeId == afterId)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    /* Edge must not close a cycle, i.e. before task must not already wait for after task */
+    pendingMask = gTaskList[beforeId].dependsOnMask;
+    while (0 != pendingMask)
+    {
+        for (taskId = 0; taskId < gTaskCnt; taskId++)
+        {
+            if (0 == (pendingMask & (1U << taskId)))
+            {
+                continue;
+            }
+
+            if (taskId == afterId)
+            {
+                return (cStatus_INVALID_ARG);
+            }
+
+            pendingMask &= (cU16_t)~(1U << taskId);
+            visitedMask |= (cU16_t)(1U << taskId);
+            pendingMask |= (gTaskList[taskId].dependsOnMask & (cU16_t)~visitedMask);
+        }
+    }
+
+    gTaskList[afterId].dependsOnMask |= (cU16_t)(1U << beforeId);
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function drops deregistered task from dependencies and renumbers tasks which move up
+ *        in the list when it gets reshuffled
+ * @param removedId - Index of deregistered task
+ */
+static void removeTaskFromDependencies(cU8_t removedId)
+{
+    cU8_t taskId;
+    cU16_t lowerMask = (cU16_t)((1U << removedId) - 1);
+    cU16_t dependsOnMask;
+
+    for (taskId = 0; taskId < SCHEDULED_TASKS_MAX; taskId++)
+    {
+        dependsOnMask = gTaskList[taskId].dependsOnMask;
+        gTaskList[taskId].dependsOnMask = (cU16_t)((dependsOnMask & lowerMask) | ((dependsOnMask >> 1) & (cU16_t)~lowerMask));
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function gives address of task function which identifies the task
+ * @param taskId - Index of task
+ * @return Address of callback or ctxCallback
+ */
+static const void *getTaskFunction(cU8_t taskId)
+{
+    if (NULL != gTaskList[taskId].ctxCallback)
+    {
+        return ((const void *)gTaskList[taskId].ctxCallback);
+    }
+
+    return ((const void *)gTaskList[taskId].callback);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function gives watchdog slots to tasks which were registered while watchdog was not started
+ */
+static void resolveTaskWatchdogSlots(void)
+{
+    cU8_t taskId;
+
+    gWatchdogStartCnt = SchedulerWatchdog_GetStartCount();
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        if (SCHEDULER_WATCHDOG_SLOT_NONE == gTaskList[taskId].watchdogSlot)
+        {
+            gTaskList[taskId].watchdogSlot = SchedulerWatchdog_AcquireSlot(getTaskFunction(taskId), gTaskList[taskId].ctx);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function executes task and accounts its run time
+ * @param taskId - Index of task
+ * @param loopStatsFlags - Enabled loop statistics
+ */
+static void runTask(cU8_t taskId, cU32_t loopStatsFlags)
+{
+    cU64_t startTimeNs;
+    cU64_t endTimeNs;
+    cU64_t runTimeNs;
+    cU64_t startCpuTimeNs = 0;
+    cU64_t watchdogToken;
+    ScheduleTaskStats_t *pStats = &gTaskList[taskId].stats;
+
+    /* Task was deregistered by task which ran before it in this release */
+    if (0 != (gTaskTombstoneMask & (1U << taskId)))
+    {
+        return;
+    }
+
+    if (0 != (loopStatsFlags & LOOP_STATS_TASK_CPU_TIME))
+    {
+        startCpuTimeNs = Utils_GetThreadCpuTimeInNanoSec();
+    }
+
+    startTimeNs = Clock_ReadNanoSec();
+    SchedulerRecord_Event(SCHEDULER_RECORD_TASK_START, getTaskFunction(taskId), gTaskList[taskId].ctx, 0, startTimeNs);
+    SCHEDULER_PROBE4(task__start, getTaskFunction(taskId), gTaskList[taskId].ctx, taskId, startTimeNs);
+    watchdogToken = SchedulerWatchdog_Begin(gTaskList[taskId].watchdogSlot, startTimeNs);
+
+    /* Execute the Task */
+    tRunningTaskId = (cI16_t)taskId;
+    if (NULL != gTaskList[taskId].ctxCallback)
+    {
+        (*gTaskList[taskId].ctxCallback)(gTaskList[taskId].ctx);
+    }
+    else
+    {
+        (*gTaskList[taskId].callback)();
+    }
+
+    tRunningTaskId = -1;
+    SchedulerWatchdog_End(watchdogToken);
+
+    /* Report of task run on worker thread is applied by loop thread once graph has completed */
+    if ((WORK_REPORT_NONE != gTaskList[taskId].workReport) && (c_TRUE == tLoopThreadF))
+    {
+        applyWorkReport(taskId);
+    }
+
+    endTimeNs = Clock_ReadNanoSec();
+    SchedulerRecord_Event(SCHEDULER_RECORD_TASK_END, getTaskFunction(taskId), gTaskList[taskId].ctx, 0, endTimeNs);
+    runTimeNs = endTimeNs - startTimeNs;
+    SCHEDULER_PROBE4(task__end, getTaskFunction(taskId), gTaskList[taskId].ctx, taskId, runTimeNs);
+    pStats->runCnt++;
+    pStats->lastRunNs = runTimeNs;
+    pStats->totalRunNs += runTimeNs;
+    if (runTimeNs > pStats->maxRunNs)
+    {
+        pStats->maxRunNs = runTimeNs;
+    }
+
+    if (0 != loopStatsFlags)
+    {
+        LoopStats_CounterAdd(&gTaskList[taskId].usage.wallTime, endTimeNs, runTimeNs);
+    }
+
+    if (0 != (loopStatsFlags & LOOP_STATS_TASK_CPU_TIME))
+    {
+        LoopStats_CounterAdd(&gTaskList[taskId].usage.cpuTime, endTimeNs,
+                             Utils_GetThreadCpuTimeInNanoSec() - startCpuTimeNs);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function executes released tasks in dependency order, on worker threads if configured,
+ *        and measures critical path of the release
+ * @param releasedMask - Tasks released on this tick
+ * @param loopStatsFlags - Enabled loop statistics
+ */
+static void executeTaskGraph(cU16_t releasedMask, cU32_t loopStatsFlags)
+{
+    cU8_t taskId;
+    cU8_t predId;
+    cU8_t pass;
+    cU64_t startTimeNs;
+    cU64_t longestPredNs;
+    cU64_t criticalPathNs = 0;
+    cU64_t pathNs[SCHEDULED_TASKS_MAX] = {0};
 
-    /* Now check the difference */
-    if (gElapsedNanoSec >= gTimerResolutionInNanoSec)
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
     {
-        do
-        {
-            /* Decrement Elapsed time */
-            gElapsedNanoSec -= gTimerResolutionInNanoSec;
+        gTaskList[taskId].readyToRun = c_FALSE;
+    }
 
-            /* Increment clock tick count */
-            for (taskId = 0; taskId < gTaskCnt; taskId++)
-            {
-                gTaskList[taskId].clockTick.clockTicksCnt++;
-            }
+    gGraphReleasedMask = releasedMask;
+    gGraphClaimedMask = 0;
+    gGraphDoneMask = 0;
+    gGraphLoopStatsFlags = loopStatsFlags;
 
-        } while (gElapsedNanoSec >= gTimerResolutionInNanoSec);
+    startTimeNs = Clock_ReadNanoSec();
+    WorkerPool_Execute(graphWorker, NULL);
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        if ((0 != (releasedMask & (1U << taskId))) && (WORK_REPORT_NONE != gTaskList[taskId].workReport))
+        {
+            applyWorkReport(taskId);
+        }
+    }
 
+    gGraphStats.releases++;
+    gGraphStats.lastMakespanNs = Clock_ReadNanoSec() - startTimeNs;
+    if (gGraphStats.lastMakespanNs > gGraphStats.maxMakespanNs)
+    {
+        gGraphStats.maxMakespanNs = gGraphStats.lastMakespanNs;
+    }
 
-        /* Compare clock tick cnt with threshold cnt */
+    /* Longest path ends at each task; chain can not be longer than number of tasks, so as many
+     * relaxation passes are enough */
+    for (pass = 0; pass < gTaskCnt; pass++)
+    {
         for (taskId = 0; taskId < gTaskCnt; taskId++)
         {
-            /*
-             * As we only derive task from TimerClockTick_t structure which are having run interval less than 1 sec
-             * So, if mClockTicksThreshold is "zero" means task run interval is >= 1 sec
-             */
-            if (0 == gTaskList[taskId].clockTick.clockTicksThreshold)
+            if (0 == (releasedMask & (1U << taskId)))
             {
                 continue;
             }
 
-            if (gTaskList[taskId].clockTick.clockTicksCnt >= gTaskList[taskId].clockTick.clockTicksThreshold)
+            longestPredNs = 0;
+            for (predId = 0; predId < gTaskCnt; predId++)
             {
-                gTaskList[taskId].clockTick.clockTicksCnt -= gTaskList[taskId].clockTick.clockTicksThreshold;
-
-                /* set timer event */
-                timerEvents |= gTaskList[taskId].runInterval;
+                if ((0 != (gTaskList[taskId].dependsOnMask & releasedMask & (1U << predId))) && (pathNs[predId] > longestPredNs))
+                {
+                    longestPredNs = pathNs[predId];
+                }
             }
-        }
-
-        /* Get Time since epoch to execute task whose run interval greater/equal to 1 sec */
-        Utils_GetTimeSinceEpoch(&curTimeStamp);
-
-        if (curTimeStamp.tm_sec != gLastTimeRefSinceEpoch.tm_sec)
-        {
-            /* set timer event for 1 sec */
-            timerEvents |= TIME_INTERVAL_1SEC;
-        }
 
-        if (curTimeStamp.tm_min != gLastTimeRefSinceEpoch.tm_min)
-        {
-            /* set timer event for 1 min */
-            timerEvents |= TIME_INTERVAL_1MIN;
+            pathNs[taskId] = gTaskList[taskId].stats.lastRunNs + longestPredNs;
         }
-
-        /* save current time as reference */
-        gLastTimeRefSinceEpoch = curTimeStamp;
     }
 
-    /** Mark all tasks ready to run */
     for (taskId = 0; taskId < gTaskCnt; taskId++)
     {
-        if (timerEvents & gTaskList[taskId].runInterval)
+        if (pathNs[taskId] > criticalPathNs)
         {
-            gTaskList[taskId].readyToRun = c_TRUE;
+            criticalPathNs = pathNs[taskId];
         }
     }
 
-    /* save current time as reference */
-    gLastMonotonicTimeInNanoSec = curMonotonicTimeInNanSec;
+    gGraphStats.lastCriticalPathNs = criticalPathNs;
+    if (criticalPathNs > gGraphStats.maxCriticalPathNs)
+    {
+        gGraphStats.maxCriticalPathNs = criticalPathNs;
+    }
 }
 
 //----------------------------------------------------------------------------
 /**
- * @brief Function that calculates the dynamic sleep time
- * @return Sleep time in nanoseconds
+ * @brief This function is run by loop thread and every worker, each takes released tasks whose
+ *        released predecessors have completed until all tasks of release have completed
+ * @param arg - Unused
  */
-cI64_t Scheduler_GetDynamicSleep(void)
+static void graphWorker(void *arg)
 {
-    static cI64_t diffNs;
-    static cU64_t endTime;
-
-    /* Add the nanoseconds of timer tick resolution to derive the Sleep */
-    gBeginTime += gTimerResolutionInNanoSec;
+    cU8_t taskId;
+    cU8_t runId = 0;
+    cU16_t runnableMask;
 
-    /* get current time */
-    endTime = Utils_GetMonotonicTimeInNanoSec();
+    (void)arg;
 
-    /* Get the Difference */
-    diffNs = gBeginTime - endTime;
+    MUTEX_LOCK(gGraphMutex);
 
-    if (diffNs > 0)
-    {
-        return (diffNs);
-    }
-    else
+    while (gGraphDoneMask != gGraphReleasedMask)
     {
-        /* convert into positive */
-        diffNs = ((-diffNs) / NANO_SECONDS_PER_MILLI_SECOND);
-        if (diffNs > 0)
+        /* Worker takes only parallel safe tasks, loop thread takes tasks pinned to it first */
+        runnableMask = 0;
+        for (taskId = 0; taskId < gTaskCnt; taskId++)
         {
-            /* Add warning only if we're delayed by minimum heart-beat interval */
-            if (diffNs > gMaxPermittedDelayMilliSec)
+            if ((0 == (gGraphReleasedMask & (cU16_t)~gGraphClaimedMask & (1U << taskId)))
+                    || (0 != (gTaskList[taskId].dependsOnMask & gGraphReleasedMask & (cU16_t)~gGraphDoneMask)))
+            {
+                continue;
+            }
+
+            if (c_FALSE == gTaskList[taskId].parallelSafe)
+            {
+                if (c_TRUE == tLoopThreadF)
+                {
+                    runnableMask = (cU16_t)(1U << taskId);
+                    runId = taskId;
+                    break;
+                }
+            }
+            else if (0 == runnableMask)
             {
-                WPRINT("we are running late by [%d]ms", (cI32_t)diffNs);
+                runnableMask = (cU16_t)(1U << taskId);
+                runId = taskId;
+                if (c_FALSE == tLoopThreadF)
+                {
+                    break;
+                }
             }
+        }
 
-            /* If we are running late by few ms then we will not sleep for 10 ms but only for 1 ms &
-             * execute the tasks again. Without this 1 ms sleep, CPU usage may go around 100%. */
-            return (BASE_SLEEP_TIME_IN_NS);
+        if (0 == runnableMask)
+        {
+            pthread_cond_wait(&gGraphCond, &gGraphMutex);
+            continue;
         }
+
+        gGraphClaimedMask |= runnableMask;
+        MUTEX_UNLOCK(gGraphMutex);
+
+        runTask(runId, gGraphLoopStatsFlags);
+
+        MUTEX_LOCK(gGraphMutex);
+        gGraphDoneMask |= runnableMask;
+        pthread_cond_broadcast(&gGraphCond);
     }
+
+    MUTEX_UNLOCK(gGraphMutex);
 }
 
 //----------------------------------------------------------------------------
 /**
- * @brief This function run all tasks that are ready to run
+ * @brief This function links all jobs of the pool into free list
  */
-void Scheduler_ExecuteTasksReadyToRun(void)
+static void initJobPool(void)
 {
-    cU8_t taskId;
+    cU32_t jobId;
 
-    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    for (jobId = 0; jobId < SCHEDULED_JOBS_MAX; jobId++)
     {
-        if (c_TRUE == gTaskList[taskId].readyToRun)
-        {
-            gTaskList[taskId].readyToRun = c_FALSE;
+        gJobPool[jobId].callback = NULL;
+        gJobPool[jobId].ctx = NULL;
+        gJobPool[jobId].dueTimeNs = 0;
+        gJobPool[jobId].next = (jobId + 1 < SCHEDULED_JOBS_MAX) ? &gJobPool[jobId + 1] : NULL;
+    }
 
-            /* Execute the Task */
-            (*gTaskList[taskId].callback)();
-        }
+    gJobFreeHead = &gJobPool[0];
+    gJobReadyHead = NULL;
+    gJobReadyTail = NULL;
+    gJobDelayedHead = NULL;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function takes job from free list
+ * @param (*callback) - Address of job function
+ * @param ctx - Application context passed to callback
+ * @return Job, NULL if callback is invalid or pool is exhausted
+ */
+static ScheduleJob_t *allocJob(void (*callback)(void *ctx), void *ctx)
+{
+    ScheduleJob_t *pJob = gJobFreeHead;
+
+    if ((NULL == callback) || (NULL == pJob))
+    {
+        return (NULL);
     }
+
+    gJobFreeHead = pJob->next;
+    pJob->callback = callback;
+    pJob->ctx = ctx;
+    pJob->next = NULL;
+    return (pJob);
 }
 
 //----------------------------------------------------------------------------
 /**
- * @brief Function checks if task is already registered or not
- * @param (*callback) - Address of function to be registered
- * @return true if already registered, false otherwise
+ * @brief This function runs jobs posted before this iteration and delayed jobs which are due
+ * @note Job is returned to free list before its callback is called, so callback can post again
  */
-static cBool isTaskAlreadyInList(void (*callback)(void))
+static void runDeferredJobs(void)
 {
-    cU8_t taskId;
+    ScheduleJob_t *pJob;
+    ScheduleJob_t *pNextJob;
+    void (*callback)(void *ctx);
+    void *ctx;
+    cU64_t curTimeNs;
+
+    /* Jobs posted by callbacks below go to next iteration */
+    pJob = gJobReadyHead;
+    gJobReadyHead = NULL;
+    gJobReadyTail = NULL;
+
+    while (NULL != pJob)
+    {
+        pNextJob = pJob->next;
+        callback = pJob->callback;
+        ctx = pJob->ctx;
 
-    /* validate arguments */
-    if (NULL == callback)
+        pJob->next = gJobFreeHead;
+        gJobFreeHead = pJob;
+
+        (*callback)(ctx);
+        pJob = pNextJob;
+    }
+
+    curTimeNs = Clock_NowNanoSec();
+
+    while ((NULL != gJobDelayedHead) && (gJobDelayedHead->dueTimeNs <= curTimeNs))
     {
-        return (c_FALSE);
+        pJob = gJobDelayedHead;
+        gJobDelayedHead = pJob->next;
+        callback = pJob->callback;
+        ctx = pJob->ctx;
+
+        pJob->next = gJobFreeHead;
+        gJobFreeHead = pJob;
+
+        (*callback)(ctx);
     }
+}
 
-    /* check whether function is already register or not */
-    for (taskId = 0; taskId < gTaskCnt ; taskId++)
+//----------------------------------------------------------------------------
+/**
+ * @brief This function derives number of ticks till earliest deferred job is due
+ * @return Number of timer ticks (at least 1), UINT32_MAX if no job is pending
+ */
+static cU32_t getTicksToNextJob(void)
+{
+    cI64_t remainingNs;
+
+    if (NULL != gJobReadyHead)
     {
-        if (callback == gTaskList[taskId].callback)
-        {
-            return (c_TRUE);
-        }
+        return (1);
     }
 
-    return (c_FALSE);
+    if (NULL == gJobDelayedHead)
+    {
+        return (UINT32_MAX);
+    }
+
+    /* Next wakeup is planned relative to begin time of current tick */
+    remainingNs = (cI64_t)gJobDelayedHead->dueTimeNs - gBeginTime;
+    if (remainingNs <= gTimerResolutionInNanoSec)
+    {
+        return (1);
+    }
+
+    return (cU32_t)((remainingNs + gTimerResolutionInNanoSec - 1) / gTimerResolutionInNanoSec);
 }
 
 //----------------------------------------------------------------------------
@@ -479,7 +3009,7 @@ static void reshuffleTaskList(void)
 
     for (taskId = 0; taskId < SCHEDULED_TASKS_MAX; taskId++)
     {
-        if (NULL == gTaskList[taskId].callback)
+        if (c_TRUE == isTaskSlotFree(&gTaskList[taskId]))
         {
             break;
         }
@@ -491,18 +3021,247 @@ static void reshuffleTaskList(void)
     /* Empty location found! So shift other tasks up in the list */
     for (shiftCnt = 1; shiftCnt < (SCHEDULED_TASKS_MAX - taskId); shiftCnt++)
     {
-        if (NULL == gTaskList[taskId + shiftCnt].callback)
+        if (c_TRUE == isTaskSlotFree(&gTaskList[taskId + shiftCnt]))
         {
             continue;
         }
 
         gTaskList[tmpTaskId++]	= gTaskList[taskId + shiftCnt];
 
-        gTaskList[taskId + shiftCnt].readyToRun = c_FALSE;
-        gTaskList[taskId + shiftCnt].runInterval = TIME_INTERVAL_NONE;
-        gTaskList[taskId + shiftCnt].callback = NULL;
-        gTaskList[taskId + shiftCnt].clockTick.clockTicksCnt = 0;
-        gTaskList[taskId + shiftCnt].clockTick.clockTicksThreshold = 0;
+        resetTaskEntry(&gTaskList[taskId + shiftCnt]);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function removes tasks deregistered during dispatch and compacts the list once
+ * @note Every tombstone scans dependency table and list is compacted once, which is O(N) with
+ *       N <= SCHEDULED_TASKS_MAX, there is no separate pending list
+ */
+static void removeTaskTombstones(void)
+{
+    cU8_t taskId;
+
+    if (0 == gTaskTombstoneMask)
+    {
+        return;
+    }
+
+    /* Highest index first, so that renumbering of dependencies does not move pending tombstones */
+    while (0 != gTaskTombstoneMask)
+    {
+        taskId = (cU8_t)(31 - __builtin_clz(gTaskTombstoneMask));
+        gTaskTombstoneMask &= (cU16_t)~(1U << taskId);
+
+        SchedulerWatchdog_ReleaseSlot(gTaskList[taskId].watchdogSlot);
+        resetTaskEntry(&gTaskList[taskId]);
+        removeTaskFromDependencies(taskId);
+
+        /* Decrease Tasks cnt */
+        gTaskCnt--;
+    }
+
+    /* Reshuffle Task List */
+    reshuffleTaskList();
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Apply in-flight policy to release of async task
+ * @param taskId - Task list index
+ */
+static void releaseAsyncTask(cU8_t taskId)
+{
+    ScheduleTask_t *pTask = &gTaskList[taskId];
+
+    if (ASYNC_STATE_IDLE == pTask->asyncState)
+    {
+        submitAsyncTask(taskId);
+    }
+    else if ((ASYNC_STATE_RUNNING == pTask->asyncState) && (SCHEDULER_ASYNC_QUEUE_ONE == pTask->asyncPolicy))
+    {
+        pTask->asyncState = ASYNC_STATE_QUEUED;
+        gAsyncStats.queued++;
+    }
+    else
+    {
+        gAsyncStats.skipped++;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Hand body of async task to executor
+ * @param taskId - Task list index
+ */
+static void submitAsyncTask(cU8_t taskId)
+{
+    ScheduleTask_t *pTask = &gTaskList[taskId];
+
+    if (cStatus_SUCCESS == AsyncExecutor_Submit(pTask->ctxCallback, pTask->asyncCompletion, pTask->ctx))
+    {
+        pTask->asyncState = ASYNC_STATE_RUNNING;
+        gAsyncStats.submitted++;
+
+        /* Executor accepts at most as many bodies as fit here */
+        gAsyncInFlight[gAsyncInFlightCnt].body = pTask->ctxCallback;
+        gAsyncInFlight[gAsyncInFlightCnt].ctx = pTask->ctx;
+        gAsyncInFlightCnt++;
+    }
+    else
+    {
+        pTask->asyncState = ASYNC_STATE_IDLE;
+        gAsyncStats.rejected++;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if body of async task has been handed to executor and its completion has not run yet
+ * @param (*body) - Task body
+ * @param ctx - Application context
+ * @return true if body is in flight
+ */
+static cBool isAsyncBodyInFlight(void (*body)(void *ctx), void *ctx)
+{
+    cU32_t flightId;
+
+    for (flightId = 0; flightId < gAsyncInFlightCnt; flightId++)
+    {
+        if ((body == gAsyncInFlight[flightId].body) && (ctx == gAsyncInFlight[flightId].ctx))
+        {
+            return (c_TRUE);
+        }
+    }
+
+    return (c_FALSE);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Run completions of async bodies which have returned, and submit queued releases
+ */
+static void runAsyncCompletions(void)
+{
+    AsyncExecutorJob_t jobs[ASYNC_EXECUTOR_QUEUE_MAX];
+    ScheduleTaskStats_t *pStats;
+    cU32_t jobCnt;
+    cU32_t jobId;
+    cU32_t flightId;
+    cI16_t taskId;
+    cBool resubmitF;
+
+    jobCnt = AsyncExecutor_PollCompleted(jobs, ASYNC_EXECUTOR_QUEUE_MAX);
+
+    for (jobId = 0; jobId < jobCnt; jobId++)
+    {
+        for (flightId = 0; flightId < gAsyncInFlightCnt; flightId++)
+        {
+            if ((jobs[jobId].body == gAsyncInFlight[flightId].body) && (jobs[jobId].ctx == gAsyncInFlight[flightId].ctx))
+            {
+                gAsyncInFlight[flightId] = gAsyncInFlight[--gAsyncInFlightCnt];
+                break;
+            }
+        }
+
+        resubmitF = c_FALSE;
+        taskId = findTask(NULL, jobs[jobId].body, jobs[jobId].ctx);
+
+        /* Task may have been deregistered while its body was running */
+        if ((taskId >= 0) && (ASYNC_STATE_IDLE != gTaskList[taskId].asyncState))
+        {
+            resubmitF = (ASYNC_STATE_QUEUED == gTaskList[taskId].asyncState) ? c_TRUE : c_FALSE;
+            gTaskList[taskId].asyncState = ASYNC_STATE_IDLE;
+
+            pStats = &gTaskList[taskId].stats;
+            pStats->runCnt++;
+            pStats->lastRunNs = jobs[jobId].runNs;
+            pStats->totalRunNs += jobs[jobId].runNs;
+            if (jobs[jobId].runNs > pStats->maxRunNs)
+            {
+                pStats->maxRunNs = jobs[jobId].runNs;
+            }
+        }
+
+        gAsyncStats.completed++;
+        (*jobs[jobId].completion)(jobs[jobId].ctx);
+
+        /* Queued release starts after completion so that body and completion never run together */
+        if (c_TRUE == resubmitF)
+        {
+            taskId = findTask(NULL, jobs[jobId].body, jobs[jobId].ctx);
+            if ((taskId >= 0) && (ASYNC_STATE_IDLE == gTaskList[taskId].asyncState))
+            {
+                submitAsyncTask((cU8_t)taskId);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Executor has completed bodies, called by Scheduler_WaitForEvents
+ * @param fd - Executor notify fd
+ * @param events - Ready events
+ * @param ctx - Not used
+ */
+static void onAsyncNotify(cI32_t fd, cU32_t events, void *ctx)
+{
+    (void)fd;
+    (void)events;
+    (void)ctx;
+
+    runAsyncCompletions();
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Completion of async task registered without completion
+ * @param ctx - Not used
+ */
+static void noAsyncCompletion(void *ctx)
+{
+    (void)ctx;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function gives offset by which task is shifted against tasks of other processes
+ * @param taskId - Index of task
+ * @param periodTicks - Period of task in ticks
+ * @return Offset in ticks, 0 for task with explicit phase
+ */
+static cU32_t getTaskStaggerTicks(cU8_t taskId, cU32_t periodTicks)
+{
+    if (c_TRUE == gTaskList[taskId].phaseExplicit)
+    {
+        return (0);
+    }
+
+    return (SchedulerCoord_GetStaggerTicks(periodTicks));
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function joins wakeup coordinator named in environment of process
+ */
+static void joinCoordinatorFromEnv(void)
+{
+    const cChar *pName = getenv(SCHEDULER_COORD_ENV_NAME);
+    const cChar *pStagger = getenv(SCHEDULER_COORD_ENV_STAGGER);
+    cStatus_e status;
+
+    if ((NULL == pName) || ('\0' == pName[0]) || (c_TRUE == SchedulerCoord_IsJoined()))
+    {
+        return;
+    }
+
+    status = SchedulerCoord_Join(pName, gTimerResolutionInMilliSec,
+                                 ((NULL != pStagger) && (0 == strcmp(pStagger, "1"))) ? c_TRUE : c_FALSE);
+    if (cStatus_SUCCESS != status)
+    {
+        WPRINT("fail to join wakeup coordinator, running standalone: [name=%s], [nmSts=%s]", pName,
+               ENUM_TO_STR_cStatus(status));
     }
 }
 
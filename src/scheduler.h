@@ -10,10 +10,21 @@
  *****************************************************************************/
 #pragma once
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*****************************************************************************
  * INCLUDES
  *****************************************************************************/
 #include "common_stddef.h"
+#include "loopStats.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Phase offset which hands the task back to automatic phase assignment */
+#define SCHEDULER_PHASE_AUTO        (UINT32_MAX)
 
 /*****************************************************************************
  * ENUMS
@@ -43,6 +54,48 @@ typedef enum
 
 }TimeInterval_e;
 
+/**
+ * @brief	Load state of super loop derived by overload controller
+ */
+typedef enum
+{
+   /** Super loop runs at configured timer resolution */
+   SCHEDULER_LOAD_NORMAL = 0,
+
+   /** Tick is coarsened and sheddable tasks are stretched */
+   SCHEDULER_LOAD_OVERLOADED
+
+}SchedulerLoadState_e;
+
+/**
+ * @brief	Phase assignment of tasks which share an interval
+ */
+typedef enum
+{
+   /** Tasks are released on their interval boundary, only explicit phases are applied */
+   SCHEDULER_STAGGER_NONE = 0,
+
+   /** Tasks are spread evenly over the ticks of their interval */
+   SCHEDULER_STAGGER_EVEN,
+
+   /** Tasks are spread by their measured average run time */
+   SCHEDULER_STAGGER_BALANCED
+
+}SchedulerStagger_e;
+
+/**
+ * @brief	Handling of async task release while its previous body is still running
+ */
+typedef enum
+{
+   /** Release is dropped */
+   SCHEDULER_ASYNC_SKIP = 0,
+
+   /** One release is kept and submitted once running body completes, further releases are dropped */
+   SCHEDULER_ASYNC_QUEUE_ONE
+
+}SchedulerAsyncPolicy_e;
+
 /*****************************************************************************
  * STRUCTURES
  *****************************************************************************/
@@ -60,7 +113,39 @@ typedef struct
 }TimerClockTick_t;
 
 /**
- * @brief	Descriptor of every periodic task
+ * @brief	Execution statistics of a task
+ */
+typedef struct
+{
+    /** Number of times task was executed */
+    cU64_t runCnt;
+
+    /** Execution time of last run in nanosec */
+    cU64_t lastRunNs;
+
+    /** Max execution time in nanosec */
+    cU64_t maxRunNs;
+
+    /** Total execution time in nanosec */
+    cU64_t totalRunNs;
+
+}ScheduleTaskStats_t;
+
+/**
+ * @brief	Windowed wall and CPU time counters of a task
+ */
+typedef struct
+{
+    /** Wall time spent in task */
+    LoopStatsCounter_t wallTime;
+
+    /** On-CPU time of task (LOOP_STATS_TASK_CPU_TIME) */
+    LoopStatsCounter_t cpuTime;
+
+}ScheduleTaskUsage_t;
+
+/**
+ * @brief	Descriptor of every periodic task (small fields first, packed without padding, counters last)
  */
 typedef struct
 {
@@ -70,14 +155,269 @@ typedef struct
     /** Base tick interval for timer task */
     cU8_t runInterval;
 
+    /** Ticks by which task release may be delayed to share a wakeup with other tasks */
+    cU16_t slackTicks;
+
     /** Timer tick calculator */
     TimerClockTick_t clockTick;
 
+    /** Release counter of sheddable task while super loop is overloaded */
+    cU16_t shedCnt;
+
+    /** Tasks of the same release which must complete before this task (bit per task list index) */
+    cU16_t dependsOnMask;
+
+    /** Ticks by which release is shifted from interval boundary (wall clock boundary for 1 sec/1 min) */
+    cU16_t phaseTicks;
+
+    /** Remaining ticks till release of 1 sec/1 min task whose boundary has passed */
+    cU16_t phaseWaitTicks;
+
+    /** Task may be stretched or skipped when super loop is overloaded */
+    cBool sheddable;
+
+    /** Phase is given by application and kept by automatic assignment */
+    cBool phaseExplicit;
+
+    /** In-flight policy of async task (SchedulerAsyncPolicy_e) */
+    cU8_t asyncPolicy;
+
+    /** Async body is idle, running or running with one release queued */
+    cU8_t asyncState;
+
+    /** Work reported by adaptive task from its current run */
+    cU8_t workReport;
+
+    /** Task may run on worker thread, it does not call scheduler or TaskTimer functions */
+    cBool parallelSafe;
+
+    /** Watchdog slot of task function, resolved at registration */
+    cU8_t watchdogSlot;
+
+    /** Period in ticks to which adaptive task returns when it finds work, 0 when task is not adaptive */
+    cU16_t basePeriodTicks;
+
+    /** Longest period in ticks to which adaptive task backs off while idle */
+    cU16_t maxPeriodTicks;
+
     /** Callback function for timer */
     void (*callback)(void);
 
+    /** Callback function which takes application context, used when callback is not given */
+    void (*ctxCallback)(void *ctx);
+
+    /** Application context passed to ctxCallback */
+    void *ctx;
+
+    /** Completion of async task run on loop thread, NULL for task which runs on loop thread (ctxCallback is its body) */
+    void (*asyncCompletion)(void *ctx);
+
+    /** Execution statistics */
+    ScheduleTaskStats_t stats;
+
+    /** Windowed time usage, updated only when loop statistics are enabled */
+    ScheduleTaskUsage_t usage;
+
 }ScheduleTask_t;
 
+/**
+ * @brief	Descriptor of one-shot deferred job
+ */
+typedef struct ScheduleJob
+{
+    /** Job function */
+    void (*callback)(void *ctx);
+
+    /** Application context passed to callback */
+    void *ctx;
+
+    /** Monotonic time from which job may run, zero to run on next iteration */
+    cU64_t dueTimeNs;
+
+    /** Next job in free, ready or delayed list */
+    struct ScheduleJob *next;
+
+}ScheduleJob_t;
+
+/**
+ * @brief	Execution statistics of a registered task along with its identity
+ */
+typedef struct
+{
+    /** Address of task function (callback or ctxCallback) */
+    const void *function;
+
+    /** Application context of task, NULL for task without context */
+    void *ctx;
+
+    /** Run interval of task */
+    TimeInterval_e runInterval;
+
+    /** Release offset from interval boundary in millisec */
+    cU32_t phaseMs;
+
+    /** Current period in millisec, 0 for task released on wall clock boundary */
+    cU32_t periodMs;
+
+    /** Execution statistics */
+    ScheduleTaskStats_t stats;
+
+}SchedulerTaskInfo_t;
+
+/**
+ * @brief	Time usage of a registered task in a statistics window
+ */
+typedef struct
+{
+    /** Address of task function (callback or ctxCallback) */
+    const void *function;
+
+    /** Application context of task, NULL for task without context */
+    void *ctx;
+
+    /** Wall time spent in task in nanosec */
+    cU64_t wallNs;
+
+    /** On-CPU time of task in nanosec, zero unless LOOP_STATS_TASK_CPU_TIME is enabled */
+    cU64_t cpuNs;
+
+}SchedulerTaskUsage_t;
+
+/**
+ * @brief	Statistics of releases executed as dependency graph
+ */
+typedef struct
+{
+    /** Number of releases executed as graph (dependencies, or parallel safe tasks with worker threads) */
+    cU64_t releases;
+
+    /** Longest chain of dependent task run times in last release in nanosec */
+    cU64_t lastCriticalPathNs;
+
+    /** Max critical path in nanosec */
+    cU64_t maxCriticalPathNs;
+
+    /** Wall time to execute all tasks of last release in nanosec */
+    cU64_t lastMakespanNs;
+
+    /** Max wall time to execute all tasks of a release in nanosec */
+    cU64_t maxMakespanNs;
+
+}SchedulerGraphStats_t;
+
+/**
+ * @brief	Statistics of async tasks
+ */
+typedef struct
+{
+    /** Bodies submitted to executor */
+    cU64_t submitted;
+
+    /** Completions run on loop thread */
+    cU64_t completed;
+
+    /** Releases dropped because body was still running */
+    cU64_t skipped;
+
+    /** Releases kept to run after running body (SCHEDULER_ASYNC_QUEUE_ONE) */
+    cU64_t queued;
+
+    /** Releases dropped because executor queue was full */
+    cU64_t rejected;
+
+}SchedulerAsyncStats_t;
+
+/**
+ * @brief	Super loop statistics
+ */
+typedef struct
+{
+    /** Number of super loop iterations (calls of Scheduler_UpdateTick) */
+    cU64_t loopIterations;
+
+    /** Number of iterations which ended after their tick deadline */
+    cU64_t lateIterations;
+
+    /** Lateness of last iteration against ideal tick timeline in nanosec */
+    cU64_t lastLatenessNs;
+
+    /** Max lateness against ideal tick timeline in nanosec */
+    cU64_t maxLatenessNs;
+
+}SchedulerLoopStats_t;
+
+/**
+ * @brief	Wakeup statistics of the scheduler super loop when wakeup coalescing is enabled
+ */
+typedef struct
+{
+    /** Number of sleeps computed by the scheduler */
+    cU64_t wakeups;
+
+    /** Number of empty timer ticks on which super loop did not wake up */
+    cU64_t idleTicksSkipped;
+
+    /** Number of distinct task deadlines that were served by an already planned wakeup */
+    cU64_t deadlinesCoalesced;
+
+}SchedulerWakeupStats_t;
+
+/**
+ * @brief	Overload controller configuration
+ */
+typedef struct
+{
+    /** Measurement window of loop utilization and lateness in millisec */
+    cU32_t windowMs;
+
+    /** Utilization (busy time of loop in percent of window) which is treated as overload */
+    cU32_t highUtilizationPercent;
+
+    /** Utilization under which load is treated as recovered */
+    cU32_t lowUtilizationPercent;
+
+    /** Lateness against ideal tick timeline which is treated as overload, 0 to ignore lateness */
+    cU32_t maxLatenessMs;
+
+    /** Number of consecutive overloaded windows before tick is coarsened further */
+    cU32_t enterWindows;
+
+    /** Number of consecutive quiet windows before tick is restored by one step */
+    cU32_t exitWindows;
+
+    /** Max multiplier of timer resolution under overload */
+    cU32_t maxTickMultiplier;
+
+}SchedulerOverloadConfig_t;
+
+/**
+ * @brief	Overload controller state
+ */
+typedef struct
+{
+    /** Current load state */
+    SchedulerLoadState_e state;
+
+    /** Current multiplier of timer resolution */
+    cU32_t tickMultiplier;
+
+    /** Current effective timer resolution in millisec */
+    cU32_t effectiveResolutionMs;
+
+    /** Loop utilization in percent measured in last window */
+    cU32_t utilizationPercent;
+
+    /** Max lateness in millisec measured in last window */
+    cU32_t maxLatenessMs;
+
+    /** Number of sheddable task releases skipped */
+    cU64_t tasksShed;
+
+    /** Number of times super loop entered overload state */
+    cU64_t overloadEntries;
+
+}SchedulerOverloadState_t;
+
 /*****************************************************************************
  * FUNCTION DECLARATIONS
  *****************************************************************************/
@@ -86,8 +426,79 @@ cBool Scheduler_Init(cU32_t timerResolutionMs, cU32_t *pMaxPermittedDelayMs);
 
 cStatus_e Scheduler_RegisterTask(void (*callback)(void), TimeInterval_e runInterval);
 
+cStatus_e Scheduler_RegisterTaskWithCtx(void (*callback)(void *ctx), void *ctx, TimeInterval_e runInterval);
+
 cStatus_e Scheduler_DeregisterTask(void (*callback)(void));
 
+cStatus_e Scheduler_DeregisterTaskWithCtx(void (*callback)(void *ctx), void *ctx);
+
+cBool Scheduler_IsTaskRegisteredWithCtx(void (*callback)(void *ctx), void *ctx);
+
+cStatus_e Scheduler_RunOnce(void (*callback)(void *ctx), void *ctx);
+
+cStatus_e Scheduler_RunAfter(cU32_t delayMs, void (*callback)(void *ctx), void *ctx);
+
+cStatus_e Scheduler_AddTaskDependency(void (*before)(void), void (*after)(void));
+
+cStatus_e Scheduler_AddTaskDependencyWithCtx(void (*before)(void *ctx), void *beforeCtx, void (*after)(void *ctx), void *afterCtx);
+
+void Scheduler_ClearTaskDependencies(void);
+
+cStatus_e Scheduler_SetWorkerThreads(cU8_t threadCnt);
+
+cStatus_e Scheduler_SetTaskParallelSafe(void (*callback)(void), cBool parallelSafe);
+
+cStatus_e Scheduler_SetTaskParallelSafeWithCtx(void (*callback)(void *ctx), void *ctx, cBool parallelSafe);
+
+void Scheduler_GetGraphStats(SchedulerGraphStats_t *pStats);
+
+cStatus_e Scheduler_RegisterAsyncTask(void (*body)(void *ctx), void (*completion)(void *ctx), void *ctx,
+                                      TimeInterval_e runInterval, SchedulerAsyncPolicy_e policy);
+
+cStatus_e Scheduler_SetAsyncThreads(cU8_t threadCnt);
+
+void Scheduler_GetAsyncStats(SchedulerAsyncStats_t *pStats);
+
+cStatus_e Scheduler_SetTaskSlack(void (*callback)(void), cU32_t slackMs);
+
+cStatus_e Scheduler_SetTaskSlackWithCtx(void (*callback)(void *ctx), void *ctx, cU32_t slackMs);
+
+void Scheduler_SetWakeupCoalescing(cBool enable);
+
+void Scheduler_SetPhaseStaggering(SchedulerStagger_e mode);
+
+cStatus_e Scheduler_SetTaskPhase(void (*callback)(void), cU32_t phaseMs);
+
+cStatus_e Scheduler_SetTaskPhaseWithCtx(void (*callback)(void *ctx), void *ctx, cU32_t phaseMs);
+
+void Scheduler_GetWakeupStats(SchedulerWakeupStats_t *pStats);
+
+cStatus_e Scheduler_SetTaskSheddable(void (*callback)(void), cBool sheddable);
+
+cStatus_e Scheduler_SetTaskSheddableWithCtx(void (*callback)(void *ctx), void *ctx, cBool sheddable);
+
+cStatus_e Scheduler_SetTaskPeriod(void (*callback)(void), cU32_t periodMs);
+
+cStatus_e Scheduler_SetTaskPeriodWithCtx(void (*callback)(void *ctx), void *ctx, cU32_t periodMs);
+
+cStatus_e Scheduler_SetTaskBackoff(void (*callback)(void), cU32_t maxPeriodMs);
+
+cStatus_e Scheduler_SetTaskBackoffWithCtx(void (*callback)(void *ctx), void *ctx, cU32_t maxPeriodMs);
+
+cStatus_e Scheduler_ReportWork(cBool foundWork);
+
+cStatus_e Scheduler_SetOverloadControl(const SchedulerOverloadConfig_t *pConfig);
+
+void Scheduler_GetOverloadState(SchedulerOverloadState_t *pState);
+
+cU32_t Scheduler_GetTimerResolution(void);
+
+void Scheduler_GetLoopStats(SchedulerLoopStats_t *pStats);
+
+cU8_t Scheduler_GetTaskInfo(SchedulerTaskInfo_t *pInfo, cU8_t maxCnt);
+
+cU8_t Scheduler_GetTaskUsage(LoopStatsWindow_e window, SchedulerTaskUsage_t *pUsage, cU8_t maxCnt);
+
 void Scheduler_Reset(void);
 
 void Scheduler_UpdateTick(void);
@@ -96,6 +507,10 @@ cI64_t Scheduler_GetDynamicSleep(void);
 
 void Scheduler_ExecuteTasksReadyToRun(void);
 
+#ifdef __cplusplus
+}
+#endif
+
 /*****************************************************************************
  * @END OF FILE
  *****************************************************************************/
@@ -0,0 +1,389 @@
+/*****************************************************************************
+ * @file    scheduler.hpp
+ * @author  Kshitij Mistry
+ * @brief   Header only C++17 layer over Task Scheduler and Task Timer modules.
+ *
+ * This header file lets C++ applications register lambdas, functors and member functions as
+ * scheduler tasks and task timers without global trampolines or heap allocated std::function.
+ * Callable is stored inline in the task/timer object (small buffer storage), object registers
+ * itself as the context of a single static trampoline, and destruction deregisters task or
+ * stops timer (RAII). Objects are move-only, so callable is never copied.
+ *
+ *      scheduler::Task<> poll([this] { PollDevice(); });
+ *      poll.Register(TIME_INTERVAL_100MS);
+ *
+ *      scheduler::Timer<> idle([this] { CloseIdleSession(); });
+ *      idle.Start(5000);
+ *
+ * @note Moving a registered task or running timer re-registers it at its new address, so task phase
+ *       restarts and timer keeps its remaining ticks. Moves are meant for setup, not for hot path.
+ *
+ *****************************************************************************/
+#pragma once
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "common_def.h"
+#include "scheduler.h"
+#include "taskTimer.h"
+
+namespace scheduler
+{
+
+/*****************************************************************************
+ * CONSTANTS
+ *****************************************************************************/
+/** Default inline storage for callable: enough for lambda capturing up to four pointers */
+inline constexpr std::size_t kDefaultInlineCapacity = (4 * sizeof(void *));
+
+/*****************************************************************************
+ * CLASSES
+ *****************************************************************************/
+/**
+ * @brief   Move-only "void()" callable holder with inline storage and without heap allocation
+ */
+template <std::size_t Capacity = kDefaultInlineCapacity>
+class InlineCallable
+{
+public:
+    InlineCallable() noexcept = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineCallable>>>
+    explicit InlineCallable(F &&fn) noexcept(std::is_nothrow_constructible_v<std::decay_t<F>, F &&>)
+    {
+        using Fn = std::decay_t<F>;
+
+        static_assert(std::is_invocable_r_v<void, Fn &>, "callable must be invocable without arguments");
+        static_assert(sizeof(Fn) <= Capacity, "callable does not fit into inline storage, increase Capacity");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable alignment is not supported");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "callable must be nothrow move constructible");
+
+        ::new (static_cast<void *>(storage_)) Fn(std::forward<F>(fn));
+        invoke_ = &invokeFn<Fn>;
+        manage_ = &manageFn<Fn>;
+    }
+
+    InlineCallable(InlineCallable &&other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    InlineCallable &operator=(InlineCallable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            moveFrom(other);
+        }
+
+        return *this;
+    }
+
+    InlineCallable(const InlineCallable &) = delete;
+    InlineCallable &operator=(const InlineCallable &) = delete;
+
+    ~InlineCallable()
+    {
+        Reset();
+    }
+
+    /** Invoke stored callable, must not be empty */
+    void operator()()
+    {
+        invoke_(storage_);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return (invoke_ != nullptr);
+    }
+
+    /** Destroy stored callable */
+    void Reset() noexcept
+    {
+        if (manage_ != nullptr)
+        {
+            manage_(nullptr, storage_);
+        }
+
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+private:
+    template <typename Fn>
+    static void invokeFn(void *storage)
+    {
+        (*static_cast<Fn *>(storage))();
+    }
+
+    /* Move construct into dst (if given) and destroy src */
+    template <typename Fn>
+    static void manageFn(void *dst, void *src) noexcept
+    {
+        if (dst != nullptr)
+        {
+            ::new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+        }
+
+        static_cast<Fn *>(src)->~Fn();
+    }
+
+    void moveFrom(InlineCallable &other) noexcept
+    {
+        if (other.manage_ == nullptr)
+        {
+            return;
+        }
+
+        other.manage_(storage_, other.storage_);
+        invoke_ = other.invoke_;
+        manage_ = other.manage_;
+        other.invoke_ = nullptr;
+        other.manage_ = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    void (*invoke_)(void *storage) = nullptr;
+    void (*manage_)(void *dst, void *src) noexcept = nullptr;
+};
+
+/**
+ * @brief   Periodic scheduler task which owns its callable and deregisters itself on destruction
+ */
+template <std::size_t Capacity = kDefaultInlineCapacity>
+class Task
+{
+public:
+    Task() noexcept = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+    explicit Task(F &&fn) noexcept(std::is_nothrow_constructible_v<InlineCallable<Capacity>, F &&>)
+        : fn_(std::forward<F>(fn))
+    {
+    }
+
+    Task(Task &&other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Deregister();
+            moveFrom(other);
+        }
+
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task()
+    {
+        Deregister();
+    }
+
+    /** Register task with scheduler to run at given interval */
+    cStatus_e Register(TimeInterval_e runInterval)
+    {
+        cStatus_e status;
+
+        if (!fn_)
+        {
+            return cStatus_INVALID_ARG;
+        }
+
+        if (registered_)
+        {
+            return cStatus_OPERATION_FAIL;
+        }
+
+        status = Scheduler_RegisterTaskWithCtx(&Task::trampoline, this, runInterval);
+        if (status != cStatus_SUCCESS)
+        {
+            return status;
+        }
+
+        registered_ = true;
+        runInterval_ = runInterval;
+
+        if (slackMs_ != 0)
+        {
+            Scheduler_SetTaskSlackWithCtx(&Task::trampoline, this, slackMs_);
+        }
+
+        return cStatus_SUCCESS;
+    }
+
+    /** Remove task from scheduler, callable is kept so task can be registered again */
+    void Deregister() noexcept
+    {
+        if (registered_)
+        {
+            Scheduler_DeregisterTaskWithCtx(&Task::trampoline, this);
+            registered_ = false;
+        }
+    }
+
+    /** Set tolerated release delay of task, applied now and on every later registration */
+    cStatus_e SetSlack(cU32_t slackMs)
+    {
+        slackMs_ = slackMs;
+        return registered_ ? Scheduler_SetTaskSlackWithCtx(&Task::trampoline, this, slackMs) : cStatus_SUCCESS;
+    }
+
+    bool IsRegistered() const noexcept
+    {
+        return registered_;
+    }
+
+private:
+    static void trampoline(void *ctx)
+    {
+        static_cast<Task *>(ctx)->fn_();
+    }
+
+    void moveFrom(Task &other) noexcept
+    {
+        cStatus_e status;
+
+        fn_ = std::move(other.fn_);
+        slackMs_ = other.slackMs_;
+        runInterval_ = other.runInterval_;
+
+        if (!other.registered_)
+        {
+            return;
+        }
+
+        /* New address is registered next to old one (contexts differ), entry of old one is freed only at
+         * end of dispatch pass when task is moved from callback */
+        status = Register(runInterval_);
+        other.Deregister();
+
+        /* Full list outside of dispatch has room once old entry is gone */
+        if (status == cStatus_NO_RESOURCE)
+        {
+            status = Register(runInterval_);
+        }
+
+        if (status != cStatus_SUCCESS)
+        {
+            EPRINT("moved task is not registered: [status=%s]", ENUM_TO_STR_cStatus(status));
+        }
+    }
+
+    InlineCallable<Capacity> fn_;
+    TimeInterval_e runInterval_ = TIME_INTERVAL_NONE;
+    cU32_t slackMs_ = 0;
+    bool registered_ = false;
+};
+
+/**
+ * @brief   Task timer which owns its callable and stops itself on destruction
+ */
+template <std::size_t Capacity = kDefaultInlineCapacity>
+class Timer
+{
+public:
+    Timer() noexcept = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Timer>>>
+    explicit Timer(F &&fn) noexcept(std::is_nothrow_constructible_v<InlineCallable<Capacity>, F &&>)
+        : fn_(std::forward<F>(fn))
+    {
+    }
+
+    Timer(Timer &&other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    Timer &operator=(Timer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Stop();
+            moveFrom(other);
+        }
+
+        return *this;
+    }
+
+    Timer(const Timer &) = delete;
+    Timer &operator=(const Timer &) = delete;
+
+    ~Timer()
+    {
+        Stop();
+    }
+
+    /** Start (or restart) single shot timer, callable may start it again from expiry */
+    bool Start(cU32_t expireAfterMs, cU32_t slackMs = 0)
+    {
+        if (!fn_)
+        {
+            return false;
+        }
+
+        return (c_TRUE == TaskTimer_StartWithSlack(&node_, expireAfterMs, slackMs, &Timer::trampoline, this));
+    }
+
+    void Stop() noexcept
+    {
+        if (IsRunning())
+        {
+            TaskTimer_Stop(&node_);
+        }
+    }
+
+    /** Timer may also be stopped by task timer module (TaskTimer_Exit, group stop), so ask its link state */
+    bool IsRunning() const noexcept
+    {
+        return (c_TRUE == TaskTimer_IsRunning(&node_));
+    }
+
+private:
+    static void trampoline(void *userData)
+    {
+        Timer *self = static_cast<Timer *>(userData);
+
+        /* Task timer module has already removed expired node from its list */
+        self->fn_();
+    }
+
+    void moveFrom(Timer &other) noexcept
+    {
+        bool wasRunning = other.IsRunning();
+        cU32_t remainingTicks = other.node_.ticks;
+        cU32_t slackTicks = other.node_.slackTicks;
+
+        other.Stop();
+        fn_ = std::move(other.fn_);
+
+        if (wasRunning)
+        {
+            /* Keep remaining ticks and slack, expiry is already aligned */
+            Start(remainingTicks * TASK_TIMER_TICK_RESOLUTION_IN_MS);
+            node_.slackTicks = slackTicks;
+        }
+    }
+
+    TaskTimer_t node_{};
+    InlineCallable<Capacity> fn_;
+};
+
+} // namespace scheduler
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,233 @@
+/*****************************************************************************
+ * @file    schedulerBatch.c
+ * @author  Kshitij Mistry
+ * @brief   Batch task of scheduler implementation file.
+ *
+ * This file implements batch tasks. Batch is registered as ordinary context task whose function
+ * collects due members and calls batch callback once. Members live in a sparse set: first memberCnt
+ * slots hold members, remaining slots hold free ids, and removal moves last member into the freed
+ * slot. Contexts are copied into a separate array before the callback, so callback may add or
+ * remove members, including the ones it was given.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_def.h"
+#include "schedulerBatch.h"
+#include <stdlib.h>
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static void runBatch(void *ctx);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that registers batch task
+ * @param pBatch - Batch handle, owned by application till batch is deregistered
+ * @param (*callback) - Called with contexts of members released on a tick, not called when none is
+ * @param batchCtx - Application context of batch
+ * @param runInterval - Interval at which batch is released
+ * @param capacity - Maximum number of members
+ * @return Error code to indicate success or failure of function
+ * @note cStatus_RESOURCE_BUSY is returned if batch is already registered, it must be deregistered first
+ */
+cStatus_e Scheduler_RegisterBatchTask(SchedulerBatch_t *pBatch, void (*callback)(void *batchCtx, void *const *ctxs, cU32_t ctxCnt),
+                                      void *batchCtx, TimeInterval_e runInterval, cU32_t capacity)
+{
+    cStatus_e status;
+    cU8_t *pBlock;
+    cU32_t slot;
+
+    if ((NULL == pBatch) || (NULL == callback) || (0 == capacity) || (capacity >= SCHEDULER_BATCH_INVALID))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    /* Handle of registered batch must keep its members and block */
+    if (c_TRUE == Scheduler_IsTaskRegisteredWithCtx(runBatch, pBatch))
+    {
+        return (cStatus_RESOURCE_BUSY);
+    }
+
+    /* All arrays in one block, largest alignment first */
+    pBlock = (cU8_t *)malloc((size_t)capacity * ((2 * sizeof(void *)) + (2 * sizeof(cU32_t)) + (2 * sizeof(cU16_t))));
+    if (NULL == pBlock)
+    {
+        return (cStatus_NO_RESOURCE);
+    }
+
+    pBatch->callback = callback;
+    pBatch->batchCtx = batchCtx;
+    pBatch->capacity = capacity;
+    pBatch->memberCnt = 0;
+    pBatch->ctxs = (void **)pBlock;
+    pBatch->released = pBatch->ctxs + capacity;
+    pBatch->slotOfId = (cU32_t *)(pBatch->released + capacity);
+    pBatch->idOfSlot = pBatch->slotOfId + capacity;
+    pBatch->dividers = (cU16_t *)(pBatch->idOfSlot + capacity);
+    pBatch->countdowns = pBatch->dividers + capacity;
+    pBatch->runCnt = 0;
+    pBatch->releasedCnt = 0;
+
+    for (slot = 0; slot < capacity; slot++)
+    {
+        pBatch->idOfSlot[slot] = slot;
+        pBatch->slotOfId[slot] = slot;
+    }
+
+    status = Scheduler_RegisterTaskWithCtx(runBatch, pBatch, runInterval);
+    if (cStatus_SUCCESS != status)
+    {
+        free(pBlock);
+        pBatch->ctxs = NULL;
+        return (status);
+    }
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that deregisters batch task and releases its members
+ * @param pBatch - Batch handle
+ * @return Error code to indicate success or failure of function
+ * @note It must not be called from callback of the same batch
+ */
+cStatus_e Scheduler_DeregisterBatchTask(SchedulerBatch_t *pBatch)
+{
+    cStatus_e status;
+
+    if ((NULL == pBatch) || (NULL == pBatch->ctxs))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    status = Scheduler_DeregisterTaskWithCtx(runBatch, pBatch);
+    if (cStatus_SUCCESS != status)
+    {
+        return (status);
+    }
+
+    free(pBatch->ctxs);
+    pBatch->ctxs = NULL;
+    pBatch->memberCnt = 0;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Add member to batch
+ * @param pBatch - Batch handle
+ * @param ctx - Member context passed to batch callback
+ * @param divider - Member is released on every divider-th release of batch, 1 for every release
+ * @param pMemberId - Member id to remove it later
+ * @return Error code to indicate success or failure of function
+ * @note Members of same divider are spread over releases of batch by their id
+ */
+cStatus_e Scheduler_BatchAdd(SchedulerBatch_t *pBatch, void *ctx, cU16_t divider, cU32_t *pMemberId)
+{
+    cU32_t slot;
+    cU32_t memberId;
+
+    if ((NULL == pBatch) || (NULL == pBatch->ctxs) || (0 == divider) || (NULL == pMemberId))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (pBatch->memberCnt >= pBatch->capacity)
+    {
+        return (cStatus_NO_RESOURCE);
+    }
+
+    slot = pBatch->memberCnt++;
+    memberId = pBatch->idOfSlot[slot];
+
+    pBatch->ctxs[slot] = ctx;
+    pBatch->dividers[slot] = divider;
+    pBatch->countdowns[slot] = (cU16_t)(1 + (memberId % divider));
+
+    *pMemberId = memberId;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Remove member from batch
+ * @param pBatch - Batch handle
+ * @param memberId - Member id returned by Scheduler_BatchAdd
+ * @return Error code to indicate success or failure of function
+ * @note Id is reused by later add, so it must not be removed twice
+ */
+cStatus_e Scheduler_BatchRemove(SchedulerBatch_t *pBatch, cU32_t memberId)
+{
+    cU32_t slot;
+    cU32_t lastSlot;
+    cU32_t lastId;
+
+    if ((NULL == pBatch) || (NULL == pBatch->ctxs) || (memberId >= pBatch->capacity))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    slot = pBatch->slotOfId[memberId];
+    if (slot >= pBatch->memberCnt)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    /* Move last member into freed slot and park freed id after members */
+    lastSlot = --pBatch->memberCnt;
+    lastId = pBatch->idOfSlot[lastSlot];
+
+    pBatch->ctxs[slot] = pBatch->ctxs[lastSlot];
+    pBatch->dividers[slot] = pBatch->dividers[lastSlot];
+    pBatch->countdowns[slot] = pBatch->countdowns[lastSlot];
+    pBatch->idOfSlot[slot] = lastId;
+    pBatch->slotOfId[lastId] = slot;
+
+    pBatch->idOfSlot[lastSlot] = memberId;
+    pBatch->slotOfId[memberId] = lastSlot;
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Task function of batch, collects due members and calls batch callback
+ * @param ctx - Batch handle
+ */
+static void runBatch(void *ctx)
+{
+    SchedulerBatch_t *pBatch = (SchedulerBatch_t *)ctx;
+    cU32_t releasedCnt = 0;
+    cU32_t slot;
+
+    for (slot = 0; slot < pBatch->memberCnt; slot++)
+    {
+        if (0 == --pBatch->countdowns[slot])
+        {
+            pBatch->countdowns[slot] = pBatch->dividers[slot];
+            pBatch->released[releasedCnt++] = pBatch->ctxs[slot];
+        }
+    }
+
+    if (0 == releasedCnt)
+    {
+        return;
+    }
+
+    pBatch->runCnt++;
+    pBatch->releasedCnt += releasedCnt;
+
+    (*pBatch->callback)(pBatch->batchCtx, pBatch->released, releasedCnt);
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * @file    schedulerBatch.h
+ * @author  Kshitij Mistry
+ * @brief   Batch task of scheduler header file.
+ *
+ * This header file defines batch tasks. A batch takes one slot of scheduler task list and holds
+ * any number of member contexts which share one callback. On every release of the batch, contexts
+ * of members which are due are collected into one array and passed to the callback in one call,
+ * so hundreds of near-identical per-device tasks cost one indirect call per tick. Members are kept
+ * in a sparse set, so adding and removing a member is O(1).
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+#include "scheduler.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Invalid batch member id */
+#define SCHEDULER_BATCH_INVALID     (UINT32_MAX)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Batch task, owned by application and managed by scheduler
+ */
+typedef struct
+{
+    /** Batch callback, gets contexts of members released on this tick */
+    void (*callback)(void *batchCtx, void *const *ctxs, cU32_t ctxCnt);
+
+    /** Application context of batch */
+    void *batchCtx;
+
+    /** Maximum number of members */
+    cU32_t capacity;
+
+    /** Number of members */
+    cU32_t memberCnt;
+
+    /** Member contexts, dense by slot */
+    void **ctxs;
+
+    /** Contexts passed to callback on current release */
+    void **released;
+
+    /** Slot of member id, valid for ids of current members */
+    cU32_t *slotOfId;
+
+    /** Member id of slot, slots from memberCnt hold free ids */
+    cU32_t *idOfSlot;
+
+    /** Member is released on every divider-th release of batch, by slot */
+    cU16_t *dividers;
+
+    /** Releases of batch left till member is released, by slot */
+    cU16_t *countdowns;
+
+    /** Number of callback calls */
+    cU64_t runCnt;
+
+    /** Number of contexts passed to callback */
+    cU64_t releasedCnt;
+
+}SchedulerBatch_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e Scheduler_RegisterBatchTask(SchedulerBatch_t *pBatch, void (*callback)(void *batchCtx, void *const *ctxs, cU32_t ctxCnt),
+                                      void *batchCtx, TimeInterval_e runInterval, cU32_t capacity);
+
+cStatus_e Scheduler_DeregisterBatchTask(SchedulerBatch_t *pBatch);
+
+cStatus_e Scheduler_BatchAdd(SchedulerBatch_t *pBatch, void *ctx, cU16_t divider, cU32_t *pMemberId);
+
+cStatus_e Scheduler_BatchRemove(SchedulerBatch_t *pBatch, cU32_t memberId);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
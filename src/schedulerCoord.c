@@ -0,0 +1,347 @@
+/*****************************************************************************
+ * @file    schedulerCoord.c
+ * @author  Kshitij Mistry
+ * @brief   Host-wide wakeup coordinator of scheduler processes implementation file.
+ *
+ * This file implements the coordinator. Segment is created zero filled, which is a valid empty
+ * page, so members never wait for each other: first member sets magic and epoch with compare and
+ * swap, and every member claims a free slot with compare and swap on its process id. A member
+ * which crashes leaves only its slot behind, which is freed by the next member that joins.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_def.h"
+#include "schedulerCoord.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Maximum length of shared memory segment name */
+#define COORD_NAME_LEN_MAX          (64)
+
+_Static_assert(sizeof(SchedulerCoordPage_t) == 4096, "coordinator page must stay one page");
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Mapped coordinator page, NULL when not joined */
+static SchedulerCoordPage_t *gCoordPage = NULL;
+
+/** Own member slot */
+static cI32_t gCoordSlot = -1;
+
+/** Own process id, stored in own slot */
+static cI32_t gCoordPid = 0;
+
+/** Longer period tasks are staggered by own slot */
+static cBool gCoordStaggerF = c_FALSE;
+
+/** Leave is registered to run at process exit */
+static cBool gCoordAtExitF = c_FALSE;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static SchedulerCoordPage_t *mapPage(const cChar *pName);
+
+static cI32_t claimSlot(SchedulerCoordPage_t *pPage, cI32_t pid);
+
+static cBool isProcessAlive(cI32_t pid);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Join coordinator page, page is created by first member
+ * @param pName - POSIX shared memory name (e.g. "/scheduler.coord")
+ * @param resolutionMs - Timer resolution of this process in millisec
+ * @param stagger - Stagger longer period tasks against other members
+ * @return Error code to indicate success or failure of function
+ * @note Tick grid is aligned on next Scheduler_Reset. Slot is given back at process exit.
+ */
+cStatus_e SchedulerCoord_Join(const cChar *pName, cU32_t resolutionMs, cBool stagger)
+{
+    SchedulerCoordPage_t *pPage;
+    cU32_t magic = 0;
+    cU64_t epochNs = 0;
+    cI32_t slot;
+
+    if ((NULL == pName) || ('/' != pName[0]) || (strlen(pName) >= COORD_NAME_LEN_MAX) || (!IS_VALID_BOOL(stagger)))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (NULL != gCoordPage)
+    {
+        return (cStatus_RESOURCE_BUSY);
+    }
+
+    pPage = mapPage(pName);
+    if (NULL == pPage)
+    {
+        return (cStatus_FILE_IO_ERR);
+    }
+
+    /* First member stamps the page, others check that it has their layout */
+    if ((c_FALSE == __atomic_compare_exchange_n(&pPage->magic, &magic, SCHEDULER_COORD_MAGIC, c_FALSE,
+                                                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            && (SCHEDULER_COORD_MAGIC != magic))
+    {
+        EPRINT("incompatible coordinator page: [name=%s], [magic=0x%x]", pName, magic);
+        munmap(pPage, sizeof(SchedulerCoordPage_t));
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    (void)__atomic_compare_exchange_n(&pPage->epochNs, &epochNs, Clock_ReadNanoSec(), c_FALSE,
+                                      __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+
+    gCoordPid = (cI32_t)getpid();
+    slot = claimSlot(pPage, gCoordPid);
+    if (slot < 0)
+    {
+        WPRINT("coordinator is full: [name=%s], [members=%d]", pName, SCHEDULER_COORD_MEMBERS_MAX);
+        munmap(pPage, sizeof(SchedulerCoordPage_t));
+        return (cStatus_NO_RESOURCE);
+    }
+
+    pPage->members[slot].resolutionMs = resolutionMs;
+    pPage->members[slot].joinTimeNs = Clock_ReadNanoSec();
+    __atomic_fetch_add(&pPage->joinCnt, 1, __ATOMIC_RELAXED);
+
+    gCoordPage = pPage;
+    gCoordSlot = slot;
+    gCoordStaggerF = stagger;
+
+    if (c_FALSE == gCoordAtExitF)
+    {
+        gCoordAtExitF = c_TRUE;
+        atexit(SchedulerCoord_Leave);
+    }
+
+    DPRINT("joined wakeup coordinator: [name=%s], [slot=%d], [members=%u]", pName, slot, SchedulerCoord_GetMemberCount());
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Give back own slot and unmap coordinator page, segment stays for other members
+ */
+void SchedulerCoord_Leave(void)
+{
+    cI32_t pid;
+
+    if (NULL == gCoordPage)
+    {
+        return;
+    }
+
+    pid = gCoordPid;
+    (void)__atomic_compare_exchange_n(&gCoordPage->members[gCoordSlot].pid, &pid, 0, c_FALSE,
+                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+
+    munmap(gCoordPage, sizeof(SchedulerCoordPage_t));
+    gCoordPage = NULL;
+    gCoordSlot = -1;
+    gCoordStaggerF = c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if process has joined coordinator
+ * @return Returns true if joined
+ */
+cBool SchedulerCoord_IsJoined(void)
+{
+    return (NULL != gCoordPage) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get latest boundary of common tick grid which is not after given time
+ * @param timeNs - Monotonic time in nanosec
+ * @param periodNs - Tick period in nanosec
+ * @return Boundary in nanosec, given time when not joined
+ */
+cU64_t SchedulerCoord_AlignNanoSec(cU64_t timeNs, cU64_t periodNs)
+{
+    cU64_t epochNs;
+
+    if ((NULL == gCoordPage) || (0 == periodNs))
+    {
+        return (timeNs);
+    }
+
+    epochNs = __atomic_load_n(&gCoordPage->epochNs, __ATOMIC_ACQUIRE);
+
+    /* Clock of this process may read slightly behind the one which set epoch */
+    if (timeNs >= epochNs)
+    {
+        return (timeNs - ((timeNs - epochNs) % periodNs));
+    }
+
+    return (timeNs - (periodNs - 1U - ((epochNs - timeNs - 1U) % periodNs)));
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get release offset by which tasks of this member are shifted against other members
+ * @param periodTicks - Period of task in ticks
+ * @return Offset in ticks, 0 when staggering is disabled or not joined
+ */
+cU32_t SchedulerCoord_GetStaggerTicks(cU32_t periodTicks)
+{
+    if ((NULL == gCoordPage) || (c_FALSE == gCoordStaggerF) || (periodTicks < 2))
+    {
+        return (0);
+    }
+
+    return ((cU32_t)gCoordSlot % periodTicks);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get number of member processes
+ * @return Number of occupied slots, slots of crashed members count till next member joins
+ */
+cU32_t SchedulerCoord_GetMemberCount(void)
+{
+    cU32_t slot;
+    cU32_t memberCnt = 0;
+
+    if (NULL == gCoordPage)
+    {
+        return (0);
+    }
+
+    for (slot = 0; slot < SCHEDULER_COORD_MEMBERS_MAX; slot++)
+    {
+        if (0 != __atomic_load_n(&gCoordPage->members[slot].pid, __ATOMIC_RELAXED))
+        {
+            memberCnt++;
+        }
+    }
+
+    return (memberCnt);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Open or create coordinator segment and map it
+ * @param pName - POSIX shared memory name
+ * @return Mapped page, NULL on failure
+ */
+static SchedulerCoordPage_t *mapPage(const cChar *pName)
+{
+    struct stat segment;
+    cI32_t fd;
+    void *pAddr;
+
+    fd = shm_open(pName, O_CREAT | O_RDWR | O_CLOEXEC, 0660);
+    if (fd < 0)
+    {
+        EPRINT("fail to open coordinator: [name=%s]", pName);
+        return (NULL);
+    }
+
+    if (0 != fstat(fd, &segment))
+    {
+        close(fd);
+        return (NULL);
+    }
+
+    /* New segment is zero filled by kernel, resizing it concurrently to same size is harmless */
+    if ((0 == segment.st_size) && (0 != ftruncate(fd, sizeof(SchedulerCoordPage_t))))
+    {
+        EPRINT("fail to resize coordinator: [name=%s]", pName);
+        close(fd);
+        return (NULL);
+    }
+
+    if ((0 != segment.st_size) && ((off_t)sizeof(SchedulerCoordPage_t) != segment.st_size))
+    {
+        EPRINT("incompatible coordinator size: [name=%s], [size=%lld]", pName, (long long)segment.st_size);
+        close(fd);
+        return (NULL);
+    }
+
+    pAddr = mmap(NULL, sizeof(SchedulerCoordPage_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (MAP_FAILED == pAddr)
+    {
+        EPRINT("fail to map coordinator: [name=%s]", pName);
+        return (NULL);
+    }
+
+    return ((SchedulerCoordPage_t *)pAddr);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Free slots of dead processes and claim a free slot
+ * @param pPage - Coordinator page
+ * @param pid - Own process id
+ * @return Slot index, -1 when all slots belong to live processes
+ */
+static cI32_t claimSlot(SchedulerCoordPage_t *pPage, cI32_t pid)
+{
+    cU32_t slot;
+    cI32_t ownerPid;
+
+    /* Members which crashed never gave back their slot */
+    for (slot = 0; slot < SCHEDULER_COORD_MEMBERS_MAX; slot++)
+    {
+        ownerPid = __atomic_load_n(&pPage->members[slot].pid, __ATOMIC_RELAXED);
+        if ((0 != ownerPid) && (c_FALSE == isProcessAlive(ownerPid))
+                && (c_TRUE == __atomic_compare_exchange_n(&pPage->members[slot].pid, &ownerPid, 0, c_FALSE,
+                                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)))
+        {
+            DPRINT("freed coordinator slot of dead member: [slot=%u], [pid=%d]", slot, ownerPid);
+        }
+    }
+
+    for (slot = 0; slot < SCHEDULER_COORD_MEMBERS_MAX; slot++)
+    {
+        ownerPid = 0;
+        if (c_TRUE == __atomic_compare_exchange_n(&pPage->members[slot].pid, &ownerPid, pid, c_FALSE,
+                                                  __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        {
+            return ((cI32_t)slot);
+        }
+    }
+
+    return (-1);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if process exists
+ * @param pid - Process id
+ * @return Returns true if process exists (or can not be checked)
+ */
+static cBool isProcessAlive(cI32_t pid)
+{
+    if ((0 != kill((pid_t)pid, 0)) && (ESRCH == errno))
+    {
+        return (c_FALSE);
+    }
+
+    return (c_TRUE);
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
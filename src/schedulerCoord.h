@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * @file    schedulerCoord.h
+ * @author  Kshitij Mistry
+ * @brief   Host-wide wakeup coordinator of scheduler processes header file.
+ *
+ * This header file defines the coordinator page which scheduler processes of one host share in a
+ * POSIX shared memory segment. Page holds a common epoch on which every member aligns its tick
+ * grid, so super loops of different processes wake up on the same boundaries and CPUs get longer
+ * idle periods in between. Members may also stagger their longer period tasks by member slot, so
+ * their heavy work does not pile up on the same tick. Page is updated only with atomic compare and
+ * swap, there is no lock which a crashed process could leave held, and slots of dead processes
+ * are freed by later members.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Magic value and layout version of coordinator page ("SCO1"), change on every incompatible change */
+#define SCHEDULER_COORD_MAGIC           (0x53434F31U)
+
+/** Maximum number of member processes */
+#define SCHEDULER_COORD_MEMBERS_MAX     (63)
+
+/** Environment variable with segment name, scheduler joins it on Scheduler_Init when set */
+#define SCHEDULER_COORD_ENV_NAME        "SCHEDULER_COORD"
+
+/** Environment variable which enables task staggering between members when set to 1 */
+#define SCHEDULER_COORD_ENV_STAGGER     "SCHEDULER_COORD_STAGGER"
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Member slot of coordinator page, one cache line
+ */
+typedef struct
+{
+    /** Process id of member, 0 when slot is free */
+    cI32_t pid;
+
+    /** Timer resolution of member in millisec */
+    cU32_t resolutionMs;
+
+    /** Monotonic time at which member joined in nanosec */
+    cU64_t joinTimeNs;
+
+    /** Reserved to keep slot on its own cache line */
+    cU8_t reserved[48];
+
+}SchedulerCoordMember_t;
+
+/**
+ * @brief   Coordinator page shared by scheduler processes, all zero is a valid empty page
+ */
+typedef struct
+{
+    /** SCHEDULER_COORD_MAGIC, set by first member */
+    cU32_t magic;
+
+    /** Reserved for alignment */
+    cU32_t reserved0;
+
+    /** Monotonic time on which tick grid of all members is aligned, set by first member */
+    cU64_t epochNs;
+
+    /** Number of joins since page was created */
+    cU64_t joinCnt;
+
+    /** Reserved to keep header on its own cache line */
+    cU8_t reserved[40];
+
+    /** Member slots */
+    SchedulerCoordMember_t members[SCHEDULER_COORD_MEMBERS_MAX];
+
+}SchedulerCoordPage_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e SchedulerCoord_Join(const cChar *pName, cU32_t resolutionMs, cBool stagger);
+
+void SchedulerCoord_Leave(void);
+
+cBool SchedulerCoord_IsJoined(void);
+
+cU64_t SchedulerCoord_AlignNanoSec(cU64_t timeNs, cU64_t periodNs);
+
+cU32_t SchedulerCoord_GetStaggerTicks(cU32_t periodTicks);
+
+cU32_t SchedulerCoord_GetMemberCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
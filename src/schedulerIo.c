@@ -0,0 +1,498 @@
+/*****************************************************************************
+ * @file    schedulerIo.c
+ * @author  Kshitij Mistry
+ * @brief   File descriptor readiness integration of scheduler super loop implementation file.
+ *
+ * This file implements watching of file descriptors from the scheduler super loop. Instead of
+ * sleeping, super loop waits on readiness backend with timeout of next timer deadline. Ready file
+ * descriptors are serviced as soon as they are reported and wait continues till the deadline.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_def.h"
+#include "common_probe.h"
+#include "common_utils.h"
+#include "schedulerIo.h"
+#include <errno.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Maximum number of watched file descriptors */
+#define FD_WATCH_MAX                (32)
+
+/** Maximum number of events fetched from backend in one wait */
+#define FD_EVENTS_PER_WAIT_MAX      (16)
+
+/** Key of watched file descriptor is made of slot index and generation of slot */
+#define FD_WATCH_KEY(slot, gen)     ((((cU32_t)(gen)) << 8) | ((cU32_t)(slot)))
+
+/** Get slot index from key */
+#define FD_WATCH_KEY_SLOT(key)      ((key) & 0xFF)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Watched file descriptor information
+ */
+typedef struct
+{
+    /** File descriptor, -1 when slot is free */
+    cI32_t fd;
+
+    /** Generation of slot to discard events of file descriptor which is already unwatched */
+    cU32_t generation;
+
+    /** Readiness callback */
+    void (*callback)(cI32_t fd, cU32_t events, void *ctx);
+
+    /** Application context */
+    void *ctx;
+
+}FdWatch_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+#ifdef __linux__
+static cBool epollOpen(void);
+
+static void epollClose(void);
+
+static cBool epollAdd(cI32_t fd, cU32_t events, cU32_t key);
+
+static cBool epollRemove(cI32_t fd);
+
+static cI32_t epollWait(cI64_t timeoutNs, SchedulerIoEvent_t *pEvents, cU32_t maxEvents);
+#endif
+
+static cBool openBackend(void);
+
+static void dispatchEvents(const SchedulerIoEvent_t *pEvents, cI32_t eventCnt);
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+#ifdef __linux__
+/** Default readiness backend based on epoll */
+static const SchedulerIoBackend_t gEpollBackend =
+{
+    "epoll", epollOpen, epollClose, epollAdd, epollRemove, epollWait
+};
+
+/** Epoll instance */
+static cI32_t gEpollFd = -1;
+
+/** Readiness backend in use */
+static const SchedulerIoBackend_t *gIoBackend = &gEpollBackend;
+#else
+/** Readiness backend in use, must be provided by application */
+static const SchedulerIoBackend_t *gIoBackend = NULL;
+#endif
+
+/** Is readiness backend opened */
+static cBool gIoBackendOpenF = c_FALSE;
+
+/** Watched file descriptors */
+static FdWatch_t gFdWatchList[FD_WATCH_MAX];
+
+/** Number of watched file descriptors */
+static cU32_t gFdWatchCnt = 0;
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Select readiness backend (e.g. io_uring) instead of default epoll backend
+ * @param pBackend - Backend operations, must stay valid while in use
+ * @return Error code to indicate success or failure of function
+ * @note Backend can be changed only while no file descriptor is watched
+ */
+cStatus_e Scheduler_SetIoBackend(const SchedulerIoBackend_t *pBackend)
+{
+    if ((NULL == pBackend) || (NULL == pBackend->open) || (NULL == pBackend->close) || (NULL == pBackend->add)
+            || (NULL == pBackend->remove) || (NULL == pBackend->wait))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (0 != gFdWatchCnt)
+    {
+        return (cStatus_RESOURCE_BUSY);
+    }
+
+    Scheduler_IoExit();
+    gIoBackend = pBackend;
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Start watching file descriptor from super loop
+ * @param fd - File descriptor
+ * @param events - Events to watch (SCHEDULER_FD_READABLE and/or SCHEDULER_FD_WRITABLE)
+ * @param callback - Routine called from super loop when file descriptor is ready
+ * @param ctx - Application context passed to callback
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_WatchFd(cI32_t fd, cU32_t events, void (*callback)(cI32_t fd, cU32_t events, void *ctx), void *ctx)
+{
+    cU32_t slot;
+    cU32_t freeSlot = FD_WATCH_MAX;
+
+    /* validate arguments */
+    if ((fd < 0) || (NULL == callback) || (0 == (events & (SCHEDULER_FD_READABLE | SCHEDULER_FD_WRITABLE))))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (c_FALSE == openBackend())
+    {
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    for (slot = 0; slot < FD_WATCH_MAX; slot++)
+    {
+        if (fd == gFdWatchList[slot].fd)
+        {
+            return (cStatus_OPERATION_FAIL);
+        }
+
+        if ((NULL == gFdWatchList[slot].callback) && (FD_WATCH_MAX == freeSlot))
+        {
+            freeSlot = slot;
+        }
+    }
+
+    if (FD_WATCH_MAX == freeSlot)
+    {
+        return (cStatus_NO_RESOURCE);
+    }
+
+    gFdWatchList[freeSlot].generation++;
+    if (c_FALSE == gIoBackend->add(fd, events, FD_WATCH_KEY(freeSlot, gFdWatchList[freeSlot].generation)))
+    {
+        EPRINT("fail to watch fd: [fd=%d], [backend=%s]", fd, gIoBackend->name);
+        return (cStatus_OPERATION_FAIL);
+    }
+
+    gFdWatchList[freeSlot].fd = fd;
+    gFdWatchList[freeSlot].callback = callback;
+    gFdWatchList[freeSlot].ctx = ctx;
+    gFdWatchCnt++;
+
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Stop watching file descriptor, it can be called from readiness callback
+ * @param fd - File descriptor
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e Scheduler_UnwatchFd(cI32_t fd)
+{
+    cU32_t slot;
+
+    if (fd < 0)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    for (slot = 0; slot < FD_WATCH_MAX; slot++)
+    {
+        if ((fd != gFdWatchList[slot].fd) || (NULL == gFdWatchList[slot].callback))
+        {
+            continue;
+        }
+
+        gIoBackend->remove(fd);
+
+        /* Next generation makes pending events of this slot stale */
+        gFdWatchList[slot].generation++;
+        gFdWatchList[slot].fd = -1;
+        gFdWatchList[slot].callback = NULL;
+        gFdWatchList[slot].ctx = NULL;
+        gFdWatchCnt--;
+        return (cStatus_SUCCESS);
+    }
+
+    return (cStatus_OPERATION_FAIL);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Wait till next timer deadline while servicing ready file descriptors
+ * @param sleepNs - Time till next timer deadline (value given by Scheduler_GetDynamicSleep)
+ * @note It replaces Utils_SleepNanoSec in super loop. If no file descriptor is watched, it simply sleeps.
+ */
+void Scheduler_WaitForEvents(cI64_t sleepNs)
+{
+    SchedulerIoEvent_t events[FD_EVENTS_PER_WAIT_MAX];
+    cU64_t curTimeNs;
+    cU64_t deadlineNs;
+    cI32_t eventCnt;
+
+    if ((0 == gFdWatchCnt) || (c_FALSE == gIoBackendOpenF))
+    {
+        Utils_SleepNanoSec((sleepNs > 0) ? (cU64_t)sleepNs : 0);
+        return;
+    }
+
+    curTimeNs = Clock_ReadNanoSec();
+    deadlineNs = curTimeNs + ((sleepNs > 0) ? (cU64_t)sleepNs : 0);
+
+    do
+    {
+        SCHEDULER_PROBE2(wait__enter, deadlineNs - curTimeNs, gFdWatchCnt);
+        eventCnt = gIoBackend->wait((cI64_t)(deadlineNs - curTimeNs), events, FD_EVENTS_PER_WAIT_MAX);
+        if (eventCnt < 0)
+        {
+            EPRINT("fail to wait for fd events: [backend=%s]", gIoBackend->name);
+            Utils_SleepNanoSec(deadlineNs - curTimeNs);
+            return;
+        }
+
+        SCHEDULER_PROBE1(wait__exit, eventCnt);
+
+        dispatchEvents(events, eventCnt);
+
+        curTimeNs = Clock_ReadNanoSec();
+
+    } while ((curTimeNs < deadlineNs) && (0 != gFdWatchCnt));
+
+    /* All file descriptors are unwatched from callbacks, sleep for remaining time */
+    if (curTimeNs < deadlineNs)
+    {
+        Utils_SleepNanoSec(deadlineNs - curTimeNs);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Unwatch all file descriptors and release readiness backend
+ */
+void Scheduler_IoExit(void)
+{
+    cU32_t slot;
+
+    for (slot = 0; slot < FD_WATCH_MAX; slot++)
+    {
+        if (NULL != gFdWatchList[slot].callback)
+        {
+            Scheduler_UnwatchFd(gFdWatchList[slot].fd);
+        }
+    }
+
+    if ((c_TRUE == gIoBackendOpenF) && (NULL != gIoBackend))
+    {
+        gIoBackend->close();
+    }
+
+    gIoBackendOpenF = c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Open readiness backend on first use
+ * @return Returns true if backend is ready to use, false otherwise
+ */
+static cBool openBackend(void)
+{
+    cU32_t slot;
+
+    if (c_TRUE == gIoBackendOpenF)
+    {
+        return (c_TRUE);
+    }
+
+    if (NULL == gIoBackend)
+    {
+        EPRINT("no fd readiness backend available");
+        return (c_FALSE);
+    }
+
+    if (c_FALSE == gIoBackend->open())
+    {
+        EPRINT("fail to open fd readiness backend: [backend=%s]", gIoBackend->name);
+        return (c_FALSE);
+    }
+
+    for (slot = 0; slot < FD_WATCH_MAX; slot++)
+    {
+        gFdWatchList[slot].fd = -1;
+        gFdWatchList[slot].callback = NULL;
+        gFdWatchList[slot].ctx = NULL;
+    }
+
+    gFdWatchCnt = 0;
+    gIoBackendOpenF = c_TRUE;
+    DPRINT("fd readiness backend opened: [backend=%s]", gIoBackend->name);
+    return (c_TRUE);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Call readiness callback of ready file descriptors
+ * @param pEvents - Events reported by backend
+ * @param eventCnt - Number of events
+ */
+static void dispatchEvents(const SchedulerIoEvent_t *pEvents, cI32_t eventCnt)
+{
+    cI32_t eventIdx;
+    FdWatch_t *pWatch;
+
+    for (eventIdx = 0; eventIdx < eventCnt; eventIdx++)
+    {
+        pWatch = &gFdWatchList[FD_WATCH_KEY_SLOT(pEvents[eventIdx].key) % FD_WATCH_MAX];
+
+        /* File descriptor may have been unwatched by earlier callback of this batch */
+        if ((NULL == pWatch->callback)
+                || (pEvents[eventIdx].key != FD_WATCH_KEY(FD_WATCH_KEY_SLOT(pEvents[eventIdx].key), pWatch->generation)))
+        {
+            continue;
+        }
+
+        pWatch->callback(pWatch->fd, pEvents[eventIdx].events, pWatch->ctx);
+    }
+}
+
+#ifdef __linux__
+//----------------------------------------------------------------------------
+/**
+ * @brief Create epoll instance
+ * @return Returns true on success, false otherwise
+ */
+static cBool epollOpen(void)
+{
+    gEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    return (gEpollFd >= 0) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Close epoll instance
+ */
+static void epollClose(void)
+{
+    if (gEpollFd >= 0)
+    {
+        close(gEpollFd);
+        gEpollFd = -1;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Add file descriptor in epoll interest list
+ * @param fd - File descriptor
+ * @param events - Events to watch
+ * @param key - Key to be reported with events
+ * @return Returns true on success, false otherwise
+ */
+static cBool epollAdd(cI32_t fd, cU32_t events, cU32_t key)
+{
+    struct epoll_event event;
+
+    memset(&event, 0, sizeof(event));
+    event.events = ((events & SCHEDULER_FD_READABLE) ? EPOLLIN : 0) | ((events & SCHEDULER_FD_WRITABLE) ? EPOLLOUT : 0);
+    event.data.u32 = key;
+
+    return (0 == epoll_ctl(gEpollFd, EPOLL_CTL_ADD, fd, &event)) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Remove file descriptor from epoll interest list
+ * @param fd - File descriptor
+ * @return Returns true on success, false otherwise
+ */
+static cBool epollRemove(cI32_t fd)
+{
+    struct epoll_event event;
+
+    /* Event is ignored but old kernels require non null pointer */
+    memset(&event, 0, sizeof(event));
+    return (0 == epoll_ctl(gEpollFd, EPOLL_CTL_DEL, fd, &event)) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Wait for ready file descriptors
+ * @param timeoutNs - Max wait time in nanosec
+ * @param pEvents - Array to which ready events will get copied
+ * @param maxEvents - Size of array
+ * @return Number of events, -1 on error
+ * @note epoll_pwait2 is used for nanosec timeout when available, otherwise timeout is rounded up to millisec
+ */
+static cI32_t epollWait(cI64_t timeoutNs, SchedulerIoEvent_t *pEvents, cU32_t maxEvents)
+{
+    struct epoll_event events[FD_EVENTS_PER_WAIT_MAX];
+    cI32_t eventCnt = -1;
+    cI32_t eventIdx;
+
+    if (maxEvents > FD_EVENTS_PER_WAIT_MAX)
+    {
+        maxEvents = FD_EVENTS_PER_WAIT_MAX;
+    }
+
+    if (timeoutNs < 0)
+    {
+        timeoutNs = 0;
+    }
+
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 35)))
+    static cBool isPwait2NotSupported = c_FALSE;
+    struct timespec timeout;
+
+    if (c_FALSE == isPwait2NotSupported)
+    {
+        timeout.tv_sec = (timeoutNs / (1000 * NANO_SECONDS_PER_MILLI_SECOND));
+        timeout.tv_nsec = (timeoutNs % (1000 * NANO_SECONDS_PER_MILLI_SECOND));
+        eventCnt = epoll_pwait2(gEpollFd, events, (cI32_t)maxEvents, &timeout, NULL);
+        if ((eventCnt < 0) && (ENOSYS == errno))
+        {
+            isPwait2NotSupported = c_TRUE;
+        }
+    }
+
+    if (c_TRUE == isPwait2NotSupported)
+#endif
+    {
+        eventCnt = epoll_wait(gEpollFd, events, (cI32_t)maxEvents,
+                              (cI32_t)((timeoutNs + NANO_SECONDS_PER_MILLI_SECOND - 1) / NANO_SECONDS_PER_MILLI_SECOND));
+    }
+
+    if (eventCnt < 0)
+    {
+        /* Signal is not an error, caller will wait again for remaining time */
+        return (EINTR == errno) ? 0 : -1;
+    }
+
+    for (eventIdx = 0; eventIdx < eventCnt; eventIdx++)
+    {
+        pEvents[eventIdx].key = events[eventIdx].data.u32;
+        pEvents[eventIdx].events = ((events[eventIdx].events & EPOLLIN) ? SCHEDULER_FD_READABLE : 0)
+                                   | ((events[eventIdx].events & EPOLLOUT) ? SCHEDULER_FD_WRITABLE : 0)
+                                   | ((events[eventIdx].events & (EPOLLERR | EPOLLHUP)) ? SCHEDULER_FD_ERROR : 0);
+    }
+
+    return (eventCnt);
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * @file    schedulerIo.h
+ * @author  Kshitij Mistry
+ * @brief   File descriptor readiness integration of scheduler super loop header file.
+ *
+ * This header file defines the interface to watch file descriptors (sockets, pipes etc.) from the
+ * scheduler super loop. Super loop waits on both next timer deadline and readiness of watched file
+ * descriptors, so that ready file descriptors are serviced immediately while task deadlines are still
+ * honored. Readiness is provided by a pluggable backend, epoll is used by default on linux.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** File descriptor is readable */
+#define SCHEDULER_FD_READABLE       (1U << 0)
+
+/** File descriptor is writable */
+#define SCHEDULER_FD_WRITABLE       (1U << 1)
+
+/** Error or hang up on file descriptor (always reported) */
+#define SCHEDULER_FD_ERROR          (1U << 2)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Ready file descriptor reported by readiness backend
+ */
+typedef struct
+{
+    /** Key given to backend when file descriptor was added */
+    cU32_t key;
+
+    /** Ready events (SCHEDULER_FD_xxx) */
+    cU32_t events;
+
+}SchedulerIoEvent_t;
+
+/**
+ * @brief   Readiness backend operations, e.g. epoll or io_uring
+ */
+typedef struct
+{
+    /** Name of backend for logging */
+    const cChar *name;
+
+    /** Create backend resources */
+    cBool (*open)(void);
+
+    /** Release backend resources */
+    void (*close)(void);
+
+    /** Start watching file descriptor for events, key must be reported back with its events */
+    cBool (*add)(cI32_t fd, cU32_t events, cU32_t key);
+
+    /** Stop watching file descriptor */
+    cBool (*remove)(cI32_t fd);
+
+    /** Wait up to timeout for ready file descriptors, returns number of events or -1 on error */
+    cI32_t (*wait)(cI64_t timeoutNs, SchedulerIoEvent_t *pEvents, cU32_t maxEvents);
+
+}SchedulerIoBackend_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e Scheduler_SetIoBackend(const SchedulerIoBackend_t *pBackend);
+
+cStatus_e Scheduler_WatchFd(cI32_t fd, cU32_t events, void (*callback)(cI32_t fd, cU32_t events, void *ctx), void *ctx);
+
+cStatus_e Scheduler_UnwatchFd(cI32_t fd);
+
+void Scheduler_WaitForEvents(cI64_t sleepNs);
+
+void Scheduler_IoExit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
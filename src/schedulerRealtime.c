@@ -0,0 +1,407 @@
+/*****************************************************************************
+ * @file    schedulerRealtime.c
+ * @author  Kshitij Mistry
+ * @brief   Real-time process profile of scheduler super loop implementation file.
+ *
+ * This file implements the real-time profile. Steps are applied in an order which keeps helper
+ * threads out of the real-time class: heap and memory lock first, then helper threads are started
+ * (they inherit policy and affinity of creator), and only then loop thread gets real-time policy
+ * and CPU affinity. Effective state is read back from the kernel, not taken from the request.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#define _GNU_SOURCE
+#include "asyncExecutor.h"
+#include "common_def.h"
+#include "scheduler.h"
+#include "schedulerRealtime.h"
+#include "workerPool.h"
+#include <alloca.h>
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** List of CPUs isolated from kernel scheduler balancing */
+#define ISOLATED_CPUS_PATH          "/sys/devices/system/cpu/isolated"
+
+/** Status of own process */
+#define PROCESS_STATUS_PATH         "/proc/self/status"
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static cU32_t reserveHeap(cU32_t bytes);
+
+static cU32_t prefaultStack(cU32_t bytes);
+
+static cBool isCpuIsolated(cI32_t cpu);
+
+static cU64_t getLockedKb(void);
+
+static void readBack(SchedulerRealtimeReport_t *pReport);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Apply real-time profile to process and loop thread and report what took effect
+ * @param pConfig - Profile configuration
+ * @param pReport - Effective state, may be NULL
+ * @return Error code to indicate success or failure of function
+ * @note Call it from loop thread after registration and before Scheduler_Reset. Steps which
+ *       succeeded stay applied when other steps fail, failed steps are set in report.
+ *       Threads created later inherit real-time policy and CPU of loop thread.
+ */
+cStatus_e Scheduler_EnableRealtime(const SchedulerRealtimeConfig_t *pConfig, SchedulerRealtimeReport_t *pReport)
+{
+    SchedulerRealtimeReport_t report;
+    struct sched_param param;
+    cpu_set_t cpuSet;
+    cU32_t requested = 0;
+
+    if (NULL == pConfig)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if ((SCHED_OTHER != pConfig->policy)
+            && ((pConfig->priority < sched_get_priority_min(pConfig->policy))
+                || (pConfig->priority > sched_get_priority_max(pConfig->policy))))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if ((pConfig->cpu >= CPU_SETSIZE) || (pConfig->cpu < -1)
+            || ((pConfig->cpu >= 0) && (pConfig->cpu >= sysconf(_SC_NPROCESSORS_CONF))))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if ((pConfig->workerThreads > WORKER_POOL_THREADS_MAX) || (pConfig->asyncThreads > ASYNC_EXECUTOR_THREADS_MAX))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    memset(&report, 0, sizeof(report));
+
+    /* Heap grows before memory is locked, so its pages are locked as well */
+    if (0 != pConfig->heapReserveBytes)
+    {
+        requested |= SCHEDULER_RT_HEAP;
+        report.heapReservedBytes = reserveHeap(pConfig->heapReserveBytes);
+        if (0 != report.heapReservedBytes)
+        {
+            report.applied |= SCHEDULER_RT_HEAP;
+        }
+    }
+
+    if (c_TRUE == pConfig->lockMemory)
+    {
+        requested |= SCHEDULER_RT_MEMLOCK;
+        if (0 != mlockall(MCL_CURRENT | MCL_FUTURE))
+        {
+            WPRINT("fail to lock memory: [%s]", strerror(errno));
+        }
+    }
+
+    /* Helper threads are started before loop thread changes class, so they do not inherit it */
+    if ((0 != pConfig->workerThreads) || (0 != pConfig->asyncThreads))
+    {
+        requested |= SCHEDULER_RT_POOLS;
+
+        if ((0 != pConfig->workerThreads) && (WorkerPool_GetThreadCount() != pConfig->workerThreads))
+        {
+            (void)Scheduler_SetWorkerThreads(pConfig->workerThreads);
+        }
+
+        if ((0 != pConfig->asyncThreads) && (AsyncExecutor_GetThreadCount() != pConfig->asyncThreads))
+        {
+            (void)Scheduler_SetAsyncThreads(pConfig->asyncThreads);
+        }
+    }
+
+    if (0 != pConfig->stackPrefaultBytes)
+    {
+        requested |= SCHEDULER_RT_STACK;
+        report.stackPrefaultBytes = prefaultStack(pConfig->stackPrefaultBytes);
+        if (0 != report.stackPrefaultBytes)
+        {
+            report.applied |= SCHEDULER_RT_STACK;
+        }
+    }
+
+    if (SCHED_OTHER != pConfig->policy)
+    {
+        requested |= SCHEDULER_RT_POLICY;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = pConfig->priority;
+        if (0 != pthread_setschedparam(pthread_self(), pConfig->policy, &param))
+        {
+            WPRINT("fail to set real-time policy: [policy=%d], [priority=%d]", pConfig->policy, pConfig->priority);
+        }
+    }
+
+    if (pConfig->cpu >= 0)
+    {
+        requested |= SCHEDULER_RT_CPU;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(pConfig->cpu, &cpuSet);
+        if (0 != pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet))
+        {
+            WPRINT("fail to pin loop thread: [cpu=%d]", pConfig->cpu);
+        }
+    }
+
+    /* Verify what actually took effect */
+    readBack(&report);
+
+    if ((SCHED_OTHER != pConfig->policy)
+            && (report.policy == pConfig->policy) && (report.priority == pConfig->priority))
+    {
+        report.applied |= SCHEDULER_RT_POLICY;
+    }
+
+    if ((c_TRUE == pConfig->lockMemory) && (0 != report.lockedKb))
+    {
+        report.applied |= SCHEDULER_RT_MEMLOCK;
+    }
+
+    if ((0 != (requested & SCHEDULER_RT_POOLS))
+            && ((0 == pConfig->workerThreads) || (report.workerThreads == pConfig->workerThreads))
+            && ((0 == pConfig->asyncThreads) || (report.asyncThreads == pConfig->asyncThreads)))
+    {
+        report.applied |= SCHEDULER_RT_POOLS;
+    }
+
+    if ((pConfig->cpu >= 0) && (report.cpu == pConfig->cpu))
+    {
+        report.applied |= SCHEDULER_RT_CPU;
+    }
+
+    report.failed = requested & ~report.applied;
+
+    IPRINT("real-time profile: [policy=%d], [priority=%d], [cpu=%d], [isolated=%d], [locked=%llu KiB], "
+           "[stack=%u], [heap=%u], [workers=%u], [async=%u], [failed=0x%x]",
+           report.policy, report.priority, report.cpu, report.cpuIsolated, (unsigned long long)report.lockedKb,
+           report.stackPrefaultBytes, report.heapReservedBytes, report.workerThreads, report.asyncThreads,
+           report.failed);
+
+    if ((pConfig->cpu >= 0) && (c_FALSE == report.cpuIsolated))
+    {
+        WPRINT("loop cpu is not isolated, other threads may run on it: [cpu=%d]", pConfig->cpu);
+    }
+
+    if (NULL != pReport)
+    {
+        *pReport = report;
+    }
+
+    return (0 == report.failed) ? cStatus_SUCCESS : cStatus_OPERATION_FAIL;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Grow heap by touching a block and keep it in allocator after it is freed
+ * @param bytes - Bytes to preallocate
+ * @return Bytes preallocated, 0 on failure
+ */
+static cU32_t reserveHeap(cU32_t bytes)
+{
+    volatile cU8_t *pBlock;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    cU32_t offset;
+
+    /* Freed memory is never trimmed and large blocks are not served by separate mmap */
+    if ((1 != mallopt(M_TRIM_THRESHOLD, -1)) || (1 != mallopt(M_MMAP_MAX, 0)))
+    {
+        return (0);
+    }
+
+    pBlock = (volatile cU8_t *)malloc(bytes);
+    if (NULL == pBlock)
+    {
+        return (0);
+    }
+
+    for (offset = 0; offset < bytes; offset += (cU32_t)pageSize)
+    {
+        pBlock[offset] = 0;
+    }
+
+    free((void *)pBlock);
+    return (bytes);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Touch stack pages below current frame so that loop does not fault on deeper calls
+ * @param bytes - Bytes to prefault
+ * @return Bytes prefaulted
+ */
+static __attribute__((noinline)) cU32_t prefaultStack(cU32_t bytes)
+{
+    volatile cU8_t *pStack;
+    struct rlimit limit;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    cU32_t offset;
+
+    /* Leave room for frames above and below, stack overflow here would kill process */
+    if ((0 == getrlimit(RLIMIT_STACK, &limit)) && (RLIM_INFINITY != limit.rlim_cur)
+            && (bytes > (limit.rlim_cur / 2)))
+    {
+        bytes = (cU32_t)(limit.rlim_cur / 2);
+    }
+
+    pStack = (volatile cU8_t *)alloca(bytes);
+
+    for (offset = 0; offset < bytes; offset += (cU32_t)pageSize)
+    {
+        pStack[offset] = 0;
+    }
+
+    return (bytes);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if CPU is in isolated CPU list of kernel
+ * @param cpu - CPU number
+ * @return Returns true if CPU is isolated
+ */
+static cBool isCpuIsolated(cI32_t cpu)
+{
+    FILE *pFile;
+    char list[256];
+    char *pToken;
+    char *pSave = NULL;
+    int first;
+    int last;
+    cBool isolated = c_FALSE;
+
+    pFile = fopen(ISOLATED_CPUS_PATH, "r");
+    if (NULL == pFile)
+    {
+        return (c_FALSE);
+    }
+
+    if (NULL == fgets(list, sizeof(list), pFile))
+    {
+        list[0] = '\0';
+    }
+
+    fclose(pFile);
+
+    /* List looks like "2-3,6" */
+    for (pToken = strtok_r(list, ",\n", &pSave); NULL != pToken; pToken = strtok_r(NULL, ",\n", &pSave))
+    {
+        if (2 != sscanf(pToken, "%d-%d", &first, &last))
+        {
+            if (1 != sscanf(pToken, "%d", &first))
+            {
+                continue;
+            }
+
+            last = first;
+        }
+
+        if ((cpu >= first) && (cpu <= last))
+        {
+            isolated = c_TRUE;
+            break;
+        }
+    }
+
+    return (isolated);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get locked memory of process
+ * @return Locked memory in KiB
+ */
+static cU64_t getLockedKb(void)
+{
+    FILE *pFile;
+    char line[128];
+    unsigned long long lockedKb = 0;
+
+    pFile = fopen(PROCESS_STATUS_PATH, "r");
+    if (NULL == pFile)
+    {
+        return (0);
+    }
+
+    while (NULL != fgets(line, sizeof(line), pFile))
+    {
+        if (1 == sscanf(line, "VmLck: %llu", &lockedKb))
+        {
+            break;
+        }
+    }
+
+    fclose(pFile);
+    return ((cU64_t)lockedKb);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Read effective state of process and loop thread from kernel
+ * @param pReport - Report to fill
+ */
+static void readBack(SchedulerRealtimeReport_t *pReport)
+{
+    struct sched_param param;
+    struct rusage usage;
+    cpu_set_t cpuSet;
+    int policy;
+    int cpu;
+
+    if (0 == pthread_getschedparam(pthread_self(), &policy, &param))
+    {
+        pReport->policy = policy;
+        pReport->priority = param.sched_priority;
+    }
+
+    pReport->cpu = -1;
+    CPU_ZERO(&cpuSet);
+    if ((0 == pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet)) && (1 == CPU_COUNT(&cpuSet)))
+    {
+        for (cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+            if (CPU_ISSET(cpu, &cpuSet))
+            {
+                pReport->cpu = cpu;
+                break;
+            }
+        }
+    }
+
+    pReport->cpuIsolated = (pReport->cpu >= 0) ? isCpuIsolated(pReport->cpu) : c_FALSE;
+    pReport->lockedKb = getLockedKb();
+    pReport->workerThreads = WorkerPool_GetThreadCount();
+    pReport->asyncThreads = AsyncExecutor_GetThreadCount();
+
+    if (0 == getrusage(RUSAGE_SELF, &usage))
+    {
+        pReport->minorFaults = (cU64_t)usage.ru_minflt;
+        pReport->majorFaults = (cU64_t)usage.ru_majflt;
+    }
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,136 @@
+/*****************************************************************************
+ * @file    schedulerRealtime.h
+ * @author  Kshitij Mistry
+ * @brief   Real-time process profile of scheduler super loop header file.
+ *
+ * This header file defines the real-time profile which is applied once from the loop thread before
+ * the super loop starts: real-time scheduling policy, locked memory, prefaulted stack and heap,
+ * helper threads started up front and loop thread pinned on an (isolated) CPU. Every step is read
+ * back after it is applied and the effective state is reported.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Real-time scheduling policy and priority of loop thread */
+#define SCHEDULER_RT_POLICY         (1U << 0)
+
+/** Current and future memory of process is locked */
+#define SCHEDULER_RT_MEMLOCK        (1U << 1)
+
+/** Stack of loop thread is prefaulted */
+#define SCHEDULER_RT_STACK          (1U << 2)
+
+/** Heap is preallocated and kept by allocator */
+#define SCHEDULER_RT_HEAP           (1U << 3)
+
+/** Worker and async executor threads are started */
+#define SCHEDULER_RT_POOLS          (1U << 4)
+
+/** Loop thread is pinned on CPU */
+#define SCHEDULER_RT_CPU            (1U << 5)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Real-time profile configuration, zero fields leave the related setting unchanged
+ */
+typedef struct
+{
+    /** Scheduling policy of loop thread, SCHED_FIFO or SCHED_RR, 0 (SCHED_OTHER) to leave unchanged */
+    cI32_t policy;
+
+    /** Real-time priority of loop thread */
+    cI32_t priority;
+
+    /** Lock current and future memory of process (mlockall) */
+    cBool lockMemory;
+
+    /** Bytes of loop thread stack to prefault, capped at half of stack limit */
+    cU32_t stackPrefaultBytes;
+
+    /** Bytes of heap to preallocate, allocator is told to never give memory back to kernel */
+    cU32_t heapReserveBytes;
+
+    /** Worker threads to start before loop thread gets real-time policy and affinity */
+    cU8_t workerThreads;
+
+    /** Async executor threads to start before loop thread gets real-time policy and affinity */
+    cU8_t asyncThreads;
+
+    /** CPU to pin loop thread on, -1 to leave affinity unchanged */
+    cI32_t cpu;
+
+}SchedulerRealtimeConfig_t;
+
+/**
+ * @brief   Effective state after real-time profile is applied
+ */
+typedef struct
+{
+    /** Steps which took effect, SCHEDULER_RT_* */
+    cU32_t applied;
+
+    /** Requested steps which did not take effect, SCHEDULER_RT_* */
+    cU32_t failed;
+
+    /** Scheduling policy of loop thread */
+    cI32_t policy;
+
+    /** Scheduling priority of loop thread */
+    cI32_t priority;
+
+    /** CPU on which loop thread may run, -1 when it may run on more than one */
+    cI32_t cpu;
+
+    /** CPU is listed in isolated CPUs of kernel (isolcpus) */
+    cBool cpuIsolated;
+
+    /** Locked memory of process in KiB (VmLck) */
+    cU64_t lockedKb;
+
+    /** Bytes of stack prefaulted */
+    cU32_t stackPrefaultBytes;
+
+    /** Bytes of heap preallocated */
+    cU32_t heapReservedBytes;
+
+    /** Running worker threads */
+    cU8_t workerThreads;
+
+    /** Running async executor threads */
+    cU8_t asyncThreads;
+
+    /** Minor page faults of process when profile was applied */
+    cU64_t minorFaults;
+
+    /** Major page faults of process when profile was applied */
+    cU64_t majorFaults;
+
+}SchedulerRealtimeReport_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e Scheduler_EnableRealtime(const SchedulerRealtimeConfig_t *pConfig, SchedulerRealtimeReport_t *pReport);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,167 @@
+/*****************************************************************************
+ * @file    schedulerRecord.c
+ * @author  Kshitij Mistry
+ * @brief   Binary recorder of scheduler events implementation file.
+ *
+ * This file implements recording of scheduler events into a file through a large stdio buffer,
+ * so that an event costs a memcpy and the file is written once per buffer. When recording is not
+ * active, every hook returns after a single flag check.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_def.h"
+#include "scheduler.h"
+#include "schedulerRecord.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Size of stdio buffer of recording file */
+#define RECORD_BUFFER_SIZE          (64 * 1024)
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Recording file, NULL when recording is not active */
+static FILE *gRecordFile = NULL;
+
+/** Buffer of recording file */
+static cChar *gRecordBuffer = NULL;
+
+/** Number of events which could not be written */
+static cU64_t gRecordDropCnt = 0;
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Start recording of scheduler events
+ * @param pPath - Path of recording file, existing file is overwritten
+ * @return Error code to indicate success or failure of function
+ * @note It should be called after Scheduler_Init
+ */
+cStatus_e SchedulerRecord_Start(const cChar *pPath)
+{
+    SchedulerRecordHeader_t header;
+
+    if (NULL == pPath)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (NULL != gRecordFile)
+    {
+        return (cStatus_RESOURCE_BUSY);
+    }
+
+    gRecordBuffer = (cChar *)malloc(RECORD_BUFFER_SIZE);
+    if (NULL == gRecordBuffer)
+    {
+        return (cStatus_NO_RESOURCE);
+    }
+
+    gRecordFile = fopen(pPath, "wb");
+    if (NULL == gRecordFile)
+    {
+        EPRINT("fail to open recording: [path=%s]", pPath);
+        free(gRecordBuffer);
+        gRecordBuffer = NULL;
+        return (cStatus_FILE_IO_ERR);
+    }
+
+    setvbuf(gRecordFile, gRecordBuffer, _IOFBF, RECORD_BUFFER_SIZE);
+
+    memset(&header, 0, sizeof(header));
+    header.magic = SCHEDULER_RECORD_MAGIC;
+    header.version = SCHEDULER_RECORD_VERSION;
+    header.recordSize = sizeof(SchedulerRecord_t);
+    header.timerResolutionMs = Scheduler_GetTimerResolution();
+    header.startTimeNs = Clock_ReadNanoSec();
+    header.startRealTimeNs = Clock_GetRealTimeNanoSec();
+
+    if (1 != fwrite(&header, sizeof(header), 1, gRecordFile))
+    {
+        EPRINT("fail to write recording: [path=%s]", pPath);
+        SchedulerRecord_Stop();
+        return (cStatus_FILE_IO_ERR);
+    }
+
+    gRecordDropCnt = 0;
+    DPRINT("recording scheduler events: [path=%s]", pPath);
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Stop recording and close recording file
+ */
+void SchedulerRecord_Stop(void)
+{
+    if (NULL == gRecordFile)
+    {
+        return;
+    }
+
+    fclose(gRecordFile);
+    gRecordFile = NULL;
+
+    free(gRecordBuffer);
+    gRecordBuffer = NULL;
+
+    if (0 != gRecordDropCnt)
+    {
+        WPRINT("events lost in recording: [count=%" PRIu64 "]", gRecordDropCnt);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if recording is active
+ * @return true if events are being recorded
+ */
+cBool SchedulerRecord_IsActive(void)
+{
+    return (NULL != gRecordFile) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Record one scheduler event
+ * @param type - Type of event
+ * @param object - Task function or TaskTimer address
+ * @param ctx - Application context of task, NULL for timer events
+ * @param arg - Event argument, see SchedulerRecordType_e
+ * @param timeNs - Time of event, zero to use current time
+ */
+void SchedulerRecord_Event(SchedulerRecordType_e type, const void *object, const void *ctx, cU32_t arg, cU64_t timeNs)
+{
+    SchedulerRecord_t record;
+
+    if (NULL == gRecordFile)
+    {
+        return;
+    }
+
+    record.timeNs = (0 != timeNs) ? timeNs : Clock_ReadNanoSec();
+    record.object = (cU64_t)(uintptr_t)object;
+    record.ctx = (cU64_t)(uintptr_t)ctx;
+    record.arg = arg;
+    record.type = (cU8_t)type;
+    memset(record.reserved, 0, sizeof(record.reserved));
+
+    if (1 != fwrite(&record, sizeof(record), 1, gRecordFile))
+    {
+        gRecordDropCnt++;
+    }
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
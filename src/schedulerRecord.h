@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * @file    schedulerRecord.h
+ * @author  Kshitij Mistry
+ * @brief   Binary recorder of scheduler events header file.
+ *
+ * This header file defines the format of schedule recordings. A recording is a file header followed
+ * by fixed size event records of task releases, task start and end, and TaskTimer start, stop and
+ * expiry. Recordings are replayed offline by tools/schedreplay.c against a virtual clock.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Magic value to identify recording ("SREC") */
+#define SCHEDULER_RECORD_MAGIC          (0x43455253U)
+
+/** Format version of recording, increment on every incompatible change */
+#define SCHEDULER_RECORD_VERSION        (1U)
+
+/** Flag in argument of release event, task is TaskTimer_Tick */
+#define SCHEDULER_RECORD_TIMER_TICK     (1U << 31)
+
+/*****************************************************************************
+ * ENUMS
+ *****************************************************************************/
+/**
+ * @brief   Type of recorded event
+ */
+typedef enum
+{
+    /** Task released, arg is run interval (TimeInterval_e) */
+    SCHEDULER_RECORD_TASK_RELEASE = 1,
+
+    /** Task callback entered */
+    SCHEDULER_RECORD_TASK_START,
+
+    /** Task callback returned */
+    SCHEDULER_RECORD_TASK_END,
+
+    /** TaskTimer started, arg is timeout in millisec */
+    SCHEDULER_RECORD_TIMER_START,
+
+    /** TaskTimer stopped before expiry */
+    SCHEDULER_RECORD_TIMER_STOP,
+
+    /** TaskTimer expired, time is callback start and arg is callback run time in nanosec */
+    SCHEDULER_RECORD_TIMER_EXPIRY,
+
+}SchedulerRecordType_e;
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Header at the beginning of recording
+ */
+typedef struct
+{
+    /** SCHEDULER_RECORD_MAGIC */
+    cU32_t magic;
+
+    /** SCHEDULER_RECORD_VERSION */
+    cU32_t version;
+
+    /** Size of one event record in bytes */
+    cU32_t recordSize;
+
+    /** Timer resolution of recorded scheduler in millisec */
+    cU32_t timerResolutionMs;
+
+    /** Monotonic time at start of recording in nanosec */
+    cU64_t startTimeNs;
+
+    /** Wall clock time at start of recording in nanosec since epoch */
+    cU64_t startRealTimeNs;
+
+}SchedulerRecordHeader_t;
+
+/**
+ * @brief   One recorded event
+ */
+typedef struct
+{
+    /** Monotonic time of event in nanosec */
+    cU64_t timeNs;
+
+    /** Task function or TaskTimer address in recorded process */
+    cU64_t object;
+
+    /** Application context of task, zero for timer events */
+    cU64_t ctx;
+
+    /** Event argument, see SchedulerRecordType_e */
+    cU32_t arg;
+
+    /** SchedulerRecordType_e */
+    cU8_t type;
+
+    /** Reserved for alignment */
+    cU8_t reserved[3];
+
+}SchedulerRecord_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e SchedulerRecord_Start(const cChar *pPath);
+
+void SchedulerRecord_Stop(void);
+
+cBool SchedulerRecord_IsActive(void);
+
+void SchedulerRecord_Event(SchedulerRecordType_e type, const void *object, const void *ctx, cU32_t arg, cU64_t timeNs);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
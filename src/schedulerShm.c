@@ -0,0 +1,215 @@
+/*****************************************************************************
+ * @file    schedulerShm.c
+ * @author  Kshitij Mistry
+ * @brief   Shared memory live statistics page of scheduler implementation file.
+ *
+ * This file implements publishing of scheduler statistics in a POSIX shared memory segment.
+ * Segment is created once, afterwards every publish is just plain stores into mapped page from
+ * the loop thread, so monitoring costs no system call and no lock to the scheduler.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_def.h"
+#include "common_utils.h"
+#include "scheduler.h"
+#include "schedulerShm.h"
+#include "taskTimer.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Maximum length of shared memory segment name */
+#define SHM_NAME_LEN_MAX            (64)
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Mapped statistics page */
+static SchedulerShmPage_t *gShmPage = NULL;
+
+/** Name of shared memory segment */
+static cChar gShmName[SHM_NAME_LEN_MAX];
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Create shared memory segment for statistics page
+ * @param pName - POSIX shared memory name (e.g. "/scheduler.1234")
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e SchedulerShm_Open(const cChar *pName)
+{
+    cI32_t fd;
+    void *pAddr;
+
+    if ((NULL == pName) || ('/' != pName[0]) || (strlen(pName) >= SHM_NAME_LEN_MAX))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (NULL != gShmPage)
+    {
+        return (cStatus_RESOURCE_BUSY);
+    }
+
+    fd = shm_open(pName, O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        EPRINT("fail to open shared memory: [name=%s]", pName);
+        return (cStatus_FILE_IO_ERR);
+    }
+
+    if (0 != ftruncate(fd, sizeof(SchedulerShmPage_t)))
+    {
+        EPRINT("fail to resize shared memory: [name=%s]", pName);
+        close(fd);
+        shm_unlink(pName);
+        return (cStatus_FILE_IO_ERR);
+    }
+
+    pAddr = mmap(NULL, sizeof(SchedulerShmPage_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (MAP_FAILED == pAddr)
+    {
+        EPRINT("fail to map shared memory: [name=%s]", pName);
+        shm_unlink(pName);
+        return (cStatus_NO_RESOURCE);
+    }
+
+    gShmPage = (SchedulerShmPage_t *)pAddr;
+    memset(gShmPage, 0, sizeof(SchedulerShmPage_t));
+    gShmPage->version = SCHEDULER_SHM_VERSION;
+    gShmPage->size = sizeof(SchedulerShmPage_t);
+    gShmPage->pid = (cI32_t)getpid();
+
+    /* Magic is written last, so reader never accepts half initialized page */
+    __atomic_store_n(&gShmPage->magic, SCHEDULER_SHM_MAGIC, __ATOMIC_RELEASE);
+
+    snprintf(gShmName, sizeof(gShmName), "%s", pName);
+    DPRINT("scheduler statistics published: [name=%s]", gShmName);
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Update statistics page, it must be called from loop thread
+ * @note It can be registered as a scheduler task, e.g. Scheduler_RegisterTask(SchedulerShm_Publish, TIME_INTERVAL_100MS)
+ */
+void SchedulerShm_Publish(void)
+{
+    SchedulerLoopStats_t loopStats;
+    SchedulerTaskInfo_t taskInfo[SCHEDULER_SHM_TASKS_MAX];
+    cU8_t taskCnt;
+    cU8_t taskId;
+    cU32_t sequence;
+
+    if (NULL == gShmPage)
+    {
+        return;
+    }
+
+    /* Collect statistics before entering write side of sequence lock to keep it short */
+    Scheduler_GetLoopStats(&loopStats);
+    taskCnt = Scheduler_GetTaskInfo(taskInfo, SCHEDULER_SHM_TASKS_MAX);
+
+    /* Make sequence odd before any store of page becomes visible */
+    sequence = gShmPage->sequence;
+    __atomic_store_n(&gShmPage->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    gShmPage->updateTimeNs = Clock_ReadNanoSec();
+    gShmPage->loopIterations = loopStats.loopIterations;
+    gShmPage->lateIterations = loopStats.lateIterations;
+    gShmPage->lastLatenessNs = loopStats.lastLatenessNs;
+    gShmPage->maxLatenessNs = loopStats.maxLatenessNs;
+    gShmPage->activeTimers = TaskTimer_GetActiveCount();
+    gShmPage->taskCnt = taskCnt;
+
+    for (taskId = 0; taskId < taskCnt; taskId++)
+    {
+        gShmPage->tasks[taskId].function = (cU64_t)(uintptr_t)taskInfo[taskId].function;
+        gShmPage->tasks[taskId].ctx = (cU64_t)(uintptr_t)taskInfo[taskId].ctx;
+        gShmPage->tasks[taskId].runInterval = (cU32_t)taskInfo[taskId].runInterval;
+        gShmPage->tasks[taskId].runCnt = taskInfo[taskId].stats.runCnt;
+        gShmPage->tasks[taskId].lastRunNs = taskInfo[taskId].stats.lastRunNs;
+        gShmPage->tasks[taskId].maxRunNs = taskInfo[taskId].stats.maxRunNs;
+        gShmPage->tasks[taskId].totalRunNs = taskInfo[taskId].stats.totalRunNs;
+    }
+
+    /* Make sequence even again once all stores of page are visible */
+    __atomic_store_n(&gShmPage->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Unmap and remove statistics page
+ */
+void SchedulerShm_Close(void)
+{
+    if (NULL == gShmPage)
+    {
+        return;
+    }
+
+    munmap(gShmPage, sizeof(SchedulerShmPage_t));
+    shm_unlink(gShmName);
+    gShmPage = NULL;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Take consistent copy of statistics page, it is used by monitor process
+ * @param pPage - Statistics page mapped by monitor
+ * @param pSnapshot - Structure to which consistent copy will get copied
+ * @return Returns true if copy is taken, false if page is not valid or publisher keeps updating it
+ */
+cBool SchedulerShm_ReadSnapshot(const SchedulerShmPage_t *pPage, SchedulerShmPage_t *pSnapshot)
+{
+    cU32_t retry;
+    cU32_t startSequence;
+
+    if ((NULL == pPage) || (NULL == pSnapshot))
+    {
+        return (c_FALSE);
+    }
+
+    if ((SCHEDULER_SHM_MAGIC != __atomic_load_n(&pPage->magic, __ATOMIC_ACQUIRE))
+            || (SCHEDULER_SHM_VERSION != pPage->version) || (sizeof(SchedulerShmPage_t) != pPage->size))
+    {
+        return (c_FALSE);
+    }
+
+    for (retry = 0; retry < 1000; retry++)
+    {
+        startSequence = __atomic_load_n(&pPage->sequence, __ATOMIC_ACQUIRE);
+        if (startSequence & 1)
+        {
+            continue;
+        }
+
+        memcpy(pSnapshot, (const void *)pPage, sizeof(SchedulerShmPage_t));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (startSequence == __atomic_load_n(&pPage->sequence, __ATOMIC_RELAXED))
+        {
+            return (c_TRUE);
+        }
+    }
+
+    return (c_FALSE);
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * @file    schedulerShm.h
+ * @author  Kshitij Mistry
+ * @brief   Shared memory live statistics page of scheduler header file.
+ *
+ * This header file defines the layout of statistics page which scheduler publishes in a POSIX
+ * shared memory segment, so that external monitors can watch the super loop. Page is updated
+ * with plain stores from the loop thread and protected by a sequence lock: writer makes sequence
+ * odd while updating and even once done, reader retries when it sees odd or changed sequence.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Magic value to identify statistics page ("SCHD") */
+#define SCHEDULER_SHM_MAGIC             (0x53434844U)
+
+/** Layout version of statistics page, increment on every incompatible change */
+#define SCHEDULER_SHM_VERSION           (1U)
+
+/** Maximum number of tasks published in statistics page */
+#define SCHEDULER_SHM_TASKS_MAX         (16)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Statistics of a task in statistics page
+ */
+typedef struct
+{
+    /** Address of task function in publisher process */
+    cU64_t function;
+
+    /** Application context of task in publisher process */
+    cU64_t ctx;
+
+    /** Run interval (TimeInterval_e) */
+    cU32_t runInterval;
+
+    /** Reserved for alignment */
+    cU32_t reserved;
+
+    /** Number of times task was executed */
+    cU64_t runCnt;
+
+    /** Execution time of last run in nanosec */
+    cU64_t lastRunNs;
+
+    /** Max execution time in nanosec */
+    cU64_t maxRunNs;
+
+    /** Total execution time in nanosec */
+    cU64_t totalRunNs;
+
+}SchedulerShmTask_t;
+
+/**
+ * @brief   Statistics page published in shared memory
+ */
+typedef struct
+{
+    /** SCHEDULER_SHM_MAGIC */
+    cU32_t magic;
+
+    /** SCHEDULER_SHM_VERSION */
+    cU32_t version;
+
+    /** Size of page in bytes */
+    cU32_t size;
+
+    /** Process id of publisher */
+    cI32_t pid;
+
+    /** Sequence lock, odd while page is being updated */
+    cU32_t sequence;
+
+    /** Number of valid entries in task array */
+    cU32_t taskCnt;
+
+    /** Monotonic time of last update in nanosec */
+    cU64_t updateTimeNs;
+
+    /** Number of super loop iterations */
+    cU64_t loopIterations;
+
+    /** Number of iterations which ended after their tick deadline */
+    cU64_t lateIterations;
+
+    /** Lateness of last iteration in nanosec */
+    cU64_t lastLatenessNs;
+
+    /** Max lateness in nanosec */
+    cU64_t maxLatenessNs;
+
+    /** Number of running task timers */
+    cU64_t activeTimers;
+
+    /** Task statistics */
+    SchedulerShmTask_t tasks[SCHEDULER_SHM_TASKS_MAX];
+
+}SchedulerShmPage_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e SchedulerShm_Open(const cChar *pName);
+
+void SchedulerShm_Publish(void);
+
+void SchedulerShm_Close(void);
+
+cBool SchedulerShm_ReadSnapshot(const SchedulerShmPage_t *pPage, SchedulerShmPage_t *pSnapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
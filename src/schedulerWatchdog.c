@@ -0,0 +1,692 @@
+/*****************************************************************************
+ * @file    schedulerWatchdog.c
+ * @author  Kshitij Mistry
+ * @brief   Watchdog of super loop callbacks implementation file.
+ *
+ * This file implements the watchdog. Published run is one 64-bit word holding start time (1024 ns
+ * units) and callback slot, so loop thread pays one store at begin and end of a callback. Slots
+ * are reference counted by registered tasks and running timers, they are acquired only while
+ * watchdog runs and by loop thread only, and monitor checks that the run is still published after
+ * reading its slot.
+ * Stack sample is taken by the loop thread itself in a signal handler.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_def.h"
+#include "schedulerWatchdog.h"
+#include <errno.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Token returned when run is not published */
+#define WATCHDOG_TOKEN_NONE             (UINT64_MAX)
+
+/** Signal used to take stack sample of loop thread */
+#define WATCHDOG_STACK_SIGNAL           (SIGRTMAX - 2)
+
+/** Max time monitor waits for stack sample in nanosec */
+#define WATCHDOG_STACK_TIMEOUT_NS       (20 * NANO_SECONDS_PER_MILLI_SECOND)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Callback tracked by watchdog
+ */
+typedef struct
+{
+    /** Address of task function or timer callback */
+    const void *function;
+
+    /** Application context of callback */
+    void *ctx;
+
+    /** Budget in millisec, 0 to use default budget, slot with declared budget is kept while unused */
+    cU32_t budgetMs;
+
+    /** Number of registered tasks and running timers which use slot */
+    cU32_t refCnt;
+
+}WatchdogSlot_t;
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Watchdog is started */
+static cBool gActiveF = c_FALSE;
+
+/** Number of times watchdog was started, callers resolve missing slots when it changes */
+static cU32_t gStartCnt = 0;
+
+/** Watchdog configuration */
+static SchedulerWatchdogConfig_t gConfig;
+
+/** Super loop thread, target of stack samples */
+static pthread_t gLoopThread;
+
+/** This thread started watchdog, runs of other threads are not published */
+static __thread cBool tLoopThreadF = c_FALSE;
+
+/** Monitor thread */
+static pthread_t gMonitorThread;
+
+/** Protects stop flag and events below */
+static pthread_mutex_t gWatchdogMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Signalled to stop monitor */
+static pthread_cond_t gStopCond;
+
+/** Monitor should exit */
+static cBool gStopF = c_FALSE;
+
+/** Published run: (start time >> 10) << 8 | slot + 1, 0 while no callback runs */
+static cU64_t gCurrentRun = 0;
+
+/** Tracked callbacks, slot is free when its function is NULL */
+static WatchdogSlot_t gSlots[SCHEDULER_WATCHDOG_SLOTS_MAX];
+
+/** Number of slots which have been used, free slots below it are reused */
+static cU32_t gSlotCnt = 0;
+
+/** Recent overruns, ring */
+static SchedulerWatchdogEvent_t gEvents[SCHEDULER_WATCHDOG_EVENTS_MAX];
+
+/** Published run of each overrun in ring, written by monitor only */
+static cU64_t gEventRuns[SCHEDULER_WATCHDOG_EVENTS_MAX];
+
+/** Number of overruns added to ring */
+static cU64_t gEventCnt = 0;
+
+/** Statistics */
+static SchedulerWatchdogStats_t gStats;
+
+/** Frames captured by signal handler */
+static void *gSampleFrames[SCHEDULER_WATCHDOG_FRAMES_MAX];
+
+/** Number of frames captured by signal handler */
+static cI32_t gSampleFrameCnt = 0;
+
+/** Signal handler has captured frames */
+static cBool gSampleDoneF = c_FALSE;
+
+/** Signal action replaced while stack samples are enabled */
+static struct sigaction gOldAction;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static cU8_t findSlot(const void *function, void *ctx, cBool addF);
+
+static void freeUnusedSlot(cU8_t slotId);
+
+static SchedulerWatchdogEvent_t *findReportedEvent(cU64_t run);
+
+static void *monitorThread(void *arg);
+
+static void checkCurrentRun(void);
+
+static void sampleLoopStack(SchedulerWatchdogEvent_t *pEvent);
+
+static void stackSignalHandler(int sig);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Start watchdog monitor thread, must be called from super loop thread
+ * @param pConfig - Watchdog configuration
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e SchedulerWatchdog_Start(const SchedulerWatchdogConfig_t *pConfig)
+{
+    pthread_condattr_t condAttr;
+    struct sigaction action;
+
+    if ((NULL == pConfig) || (0 == pConfig->checkIntervalMs))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (c_TRUE == gActiveF)
+    {
+        return (cStatus_RESOURCE_BUSY);
+    }
+
+    Clock_Init();
+
+    gConfig = *pConfig;
+    gLoopThread = pthread_self();
+    tLoopThreadF = c_TRUE;
+    gStopF = c_FALSE;
+    __atomic_store_n(&gCurrentRun, 0, __ATOMIC_RELAXED);
+
+    if (c_TRUE == gConfig.captureStack)
+    {
+        /* First backtrace loads unwinder, which is not safe inside signal handler */
+        gSampleFrameCnt = backtrace(gSampleFrames, SCHEDULER_WATCHDOG_FRAMES_MAX);
+
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = stackSignalHandler;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (0 != sigaction(WATCHDOG_STACK_SIGNAL, &action, &gOldAction))
+        {
+            EPRINT("fail to install stack sample handler");
+            return (cStatus_OPERATION_FAIL);
+        }
+    }
+
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&gStopCond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+
+    if (0 != pthread_create(&gMonitorThread, NULL, monitorThread, NULL))
+    {
+        EPRINT("fail to create watchdog thread");
+        pthread_cond_destroy(&gStopCond);
+        if (c_TRUE == gConfig.captureStack)
+        {
+            sigaction(WATCHDOG_STACK_SIGNAL, &gOldAction, NULL);
+        }
+        return (cStatus_NO_RESOURCE);
+    }
+
+    gActiveF = c_TRUE;
+    gStartCnt++;
+    DPRINT("watchdog started: [interval=%u ms], [default budget=%u ms]", gConfig.checkIntervalMs, gConfig.defaultBudgetMs);
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Stop and join watchdog monitor thread
+ */
+void SchedulerWatchdog_Stop(void)
+{
+    if (c_FALSE == gActiveF)
+    {
+        return;
+    }
+
+    MUTEX_LOCK(gWatchdogMutex);
+    gStopF = c_TRUE;
+    pthread_cond_signal(&gStopCond);
+    MUTEX_UNLOCK(gWatchdogMutex);
+
+    pthread_join(gMonitorThread, NULL);
+    pthread_cond_destroy(&gStopCond);
+
+    if (c_TRUE == gConfig.captureStack)
+    {
+        sigaction(WATCHDOG_STACK_SIGNAL, &gOldAction, NULL);
+    }
+
+    gActiveF = c_FALSE;
+    tLoopThreadF = c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if watchdog is started
+ * @return true if started
+ */
+cBool SchedulerWatchdog_IsActive(void)
+{
+    return (gActiveF);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get number of times watchdog was started
+ * @return Start count, callbacks registered before latest start are given slots when it changes
+ */
+cU32_t SchedulerWatchdog_GetStartCount(void)
+{
+    return (gStartCnt);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Declare budget of a callback, may be called before watchdog is started, loop thread only
+ * @param function - Address of task function or timer callback
+ * @param ctx - Application context of callback (timer userData for timer callback)
+ * @param budgetMs - Budget in millisec, 0 to use default budget
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e SchedulerWatchdog_SetBudget(const void *function, void *ctx, cU32_t budgetMs)
+{
+    cU8_t slotId;
+
+    if (NULL == function)
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    slotId = findSlot(function, ctx, (0 != budgetMs) ? c_TRUE : c_FALSE);
+    if (SCHEDULER_WATCHDOG_SLOT_NONE == slotId)
+    {
+        return (0 != budgetMs) ? cStatus_NO_RESOURCE : cStatus_SUCCESS;
+    }
+
+    __atomic_store_n(&gSlots[slotId].budgetMs, budgetMs, __ATOMIC_RELAXED);
+    freeUnusedSlot(slotId);
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get slot of callback for a registered task or started timer, loop thread only
+ * @param function - Address of task function or timer callback
+ * @param ctx - Application context of callback (timer userData for timer callback)
+ * @return Slot index, SCHEDULER_WATCHDOG_SLOT_NONE if watchdog is not started or slots are full
+ * @note Every acquired slot must be given back with SchedulerWatchdog_ReleaseSlot. It costs one
+ *       flag check while watchdog is not started, so task registration and timer start stay O(1).
+ */
+cU8_t SchedulerWatchdog_AcquireSlot(const void *function, void *ctx)
+{
+    cU8_t slotId;
+
+    if (c_FALSE == gActiveF)
+    {
+        return (SCHEDULER_WATCHDOG_SLOT_NONE);
+    }
+
+    slotId = findSlot(function, ctx, c_TRUE);
+
+    if (SCHEDULER_WATCHDOG_SLOT_NONE == slotId)
+    {
+        __atomic_fetch_add(&gStats.untracked, 1, __ATOMIC_RELAXED);
+        return (SCHEDULER_WATCHDOG_SLOT_NONE);
+    }
+
+    gSlots[slotId].refCnt++;
+    return (slotId);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Give back slot when task is deregistered or timer is stopped or has expired, loop thread only
+ * @param slotId - Slot returned by SchedulerWatchdog_AcquireSlot
+ */
+void SchedulerWatchdog_ReleaseSlot(cU8_t slotId)
+{
+    if ((slotId >= SCHEDULER_WATCHDOG_SLOTS_MAX) || (0 == gSlots[slotId].refCnt))
+    {
+        return;
+    }
+
+    gSlots[slotId].refCnt--;
+    freeUnusedSlot(slotId);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Publish start of callback run
+ * @param slotId - Slot of callback
+ * @param startNs - Start time (Clock_ReadNanoSec), 0 to read clock
+ * @return Token to be passed to SchedulerWatchdog_End
+ * @note Runs of threads other than the one which started watchdog are not published
+ */
+cU64_t SchedulerWatchdog_Begin(cU8_t slotId, cU64_t startNs)
+{
+    cU64_t token;
+
+    if ((c_FALSE == gActiveF) || (c_FALSE == tLoopThreadF))
+    {
+        return (WATCHDOG_TOKEN_NONE);
+    }
+
+    if (0 == startNs)
+    {
+        startNs = Clock_ReadNanoSec();
+    }
+
+    /* Run which was published before (timer pass of TaskTimer_Tick task) continues after this one */
+    token = __atomic_load_n(&gCurrentRun, __ATOMIC_RELAXED);
+    __atomic_store_n(&gCurrentRun, ((startNs >> 10) << 8) | (cU8_t)(slotId + 1), __ATOMIC_RELEASE);
+
+    return (token);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Publish end of callback run
+ * @param token - Value returned by SchedulerWatchdog_Begin
+ */
+void SchedulerWatchdog_End(cU64_t token)
+{
+    if (WATCHDOG_TOKEN_NONE == token)
+    {
+        return;
+    }
+
+    __atomic_store_n(&gCurrentRun, token, __ATOMIC_RELEASE);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get recent overruns, latest first
+ * @param pEvents - Array to which overruns will get copied
+ * @param maxCnt - Size of array
+ * @return Number of overruns copied
+ */
+cU32_t SchedulerWatchdog_GetEvents(SchedulerWatchdogEvent_t *pEvents, cU32_t maxCnt)
+{
+    cU32_t eventCnt = 0;
+
+    if (NULL == pEvents)
+    {
+        return (0);
+    }
+
+    MUTEX_LOCK(gWatchdogMutex);
+
+    while ((eventCnt < maxCnt) && (eventCnt < SCHEDULER_WATCHDOG_EVENTS_MAX) && (eventCnt < gEventCnt))
+    {
+        pEvents[eventCnt] = gEvents[(gEventCnt - 1 - eventCnt) % SCHEDULER_WATCHDOG_EVENTS_MAX];
+        eventCnt++;
+    }
+
+    MUTEX_UNLOCK(gWatchdogMutex);
+
+    return (eventCnt);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get watchdog statistics
+ * @param pStats - Structure to which statistics will get copied
+ */
+void SchedulerWatchdog_GetStats(SchedulerWatchdogStats_t *pStats)
+{
+    if (NULL == pStats)
+    {
+        return;
+    }
+
+    MUTEX_LOCK(gWatchdogMutex);
+    *pStats = gStats;
+    MUTEX_UNLOCK(gWatchdogMutex);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Find slot of callback, called by loop thread only
+ * @param function - Address of callback
+ * @param ctx - Application context of callback
+ * @param addF - Add slot when callback has none
+ * @return Slot index, SCHEDULER_WATCHDOG_SLOT_NONE if not found or slots are full
+ */
+static cU8_t findSlot(const void *function, void *ctx, cBool addF)
+{
+    cU32_t slotId;
+    cU32_t freeSlotId = SCHEDULER_WATCHDOG_SLOT_NONE;
+
+    for (slotId = 0; slotId < gSlotCnt; slotId++)
+    {
+        if ((function == gSlots[slotId].function) && (ctx == gSlots[slotId].ctx))
+        {
+            return ((cU8_t)slotId);
+        }
+
+        if ((NULL == gSlots[slotId].function) && (SCHEDULER_WATCHDOG_SLOT_NONE == freeSlotId))
+        {
+            freeSlotId = slotId;
+        }
+    }
+
+    if (c_FALSE == addF)
+    {
+        return (SCHEDULER_WATCHDOG_SLOT_NONE);
+    }
+
+    if (SCHEDULER_WATCHDOG_SLOT_NONE == freeSlotId)
+    {
+        if (gSlotCnt >= SCHEDULER_WATCHDOG_SLOTS_MAX)
+        {
+            return (SCHEDULER_WATCHDOG_SLOT_NONE);
+        }
+
+        freeSlotId = gSlotCnt++;
+    }
+
+    /* Slot is filled before it gets published, monitor reads it after acquire of published run */
+    gSlots[freeSlotId].ctx = ctx;
+    gSlots[freeSlotId].budgetMs = 0;
+    gSlots[freeSlotId].refCnt = 0;
+    __atomic_store_n(&gSlots[freeSlotId].function, function, __ATOMIC_RELEASE);
+
+    return ((cU8_t)freeSlotId);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Free slot which is neither used nor has declared budget
+ * @param slotId - Slot index
+ */
+static void freeUnusedSlot(cU8_t slotId)
+{
+    if ((0 == gSlots[slotId].refCnt) && (0 == gSlots[slotId].budgetMs))
+    {
+        __atomic_store_n(&gSlots[slotId].function, NULL, __ATOMIC_RELEASE);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Find overrun of run in ring, called by monitor thread only
+ * @param run - Published run
+ * @return Overrun, NULL when run has not been reported
+ */
+static SchedulerWatchdogEvent_t *findReportedEvent(cU64_t run)
+{
+    cU64_t eventId;
+
+    for (eventId = gEventCnt; (eventId > 0) && ((gEventCnt - eventId) < SCHEDULER_WATCHDOG_EVENTS_MAX); eventId--)
+    {
+        if (run == gEventRuns[(eventId - 1) % SCHEDULER_WATCHDOG_EVENTS_MAX])
+        {
+            return (&gEvents[(eventId - 1) % SCHEDULER_WATCHDOG_EVENTS_MAX]);
+        }
+    }
+
+    return (NULL);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Monitor thread checks published run every check interval
+ * @param arg - Not used
+ * @return NULL
+ */
+static void *monitorThread(void *arg)
+{
+    struct timespec wakeupTime;
+    cU64_t wakeupNs;
+
+    (void)arg;
+
+    clock_gettime(CLOCK_MONOTONIC, &wakeupTime);
+    wakeupNs = ((cU64_t)wakeupTime.tv_sec * 1000000000ULL) + (cU64_t)wakeupTime.tv_nsec;
+
+    MUTEX_LOCK(gWatchdogMutex);
+
+    while (c_FALSE == gStopF)
+    {
+        wakeupNs += (cU64_t)gConfig.checkIntervalMs * NANO_SECONDS_PER_MILLI_SECOND;
+        wakeupTime.tv_sec = (time_t)(wakeupNs / 1000000000ULL);
+        wakeupTime.tv_nsec = (long)(wakeupNs % 1000000000ULL);
+
+        while ((c_FALSE == gStopF) && (ETIMEDOUT != pthread_cond_timedwait(&gStopCond, &gWatchdogMutex, &wakeupTime)))
+        {
+            continue;
+        }
+
+        if (c_TRUE == gStopF)
+        {
+            break;
+        }
+
+        gStats.checks++;
+        MUTEX_UNLOCK(gWatchdogMutex);
+
+        checkCurrentRun();
+
+        MUTEX_LOCK(gWatchdogMutex);
+    }
+
+    MUTEX_UNLOCK(gWatchdogMutex);
+    return (NULL);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Report published run if it exceeded its budget, once per run
+ */
+static void checkCurrentRun(void)
+{
+    SchedulerWatchdogEvent_t event;
+    SchedulerWatchdogEvent_t *pReportedEvent;
+    cU64_t currentRun = __atomic_load_n(&gCurrentRun, __ATOMIC_ACQUIRE);
+    cU64_t curTimeNs;
+    cU8_t slotId;
+    cChar **ppSymbols;
+
+    if (0 == currentRun)
+    {
+        return;
+    }
+
+    memset(&event, 0, sizeof(event));
+    slotId = (cU8_t)((currentRun & 0xFF) - 1);
+    event.startNs = (currentRun >> 8) << 10;
+    event.budgetMs = gConfig.defaultBudgetMs;
+
+    if (SCHEDULER_WATCHDOG_SLOT_NONE != slotId)
+    {
+        event.function = __atomic_load_n(&gSlots[slotId].function, __ATOMIC_ACQUIRE);
+        event.ctx = gSlots[slotId].ctx;
+        if (0 != __atomic_load_n(&gSlots[slotId].budgetMs, __ATOMIC_RELAXED))
+        {
+            event.budgetMs = gSlots[slotId].budgetMs;
+        }
+
+        /* Slot may have been reused once the run ended, it is checked again on next interval */
+        if (currentRun != __atomic_load_n(&gCurrentRun, __ATOMIC_ACQUIRE))
+        {
+            return;
+        }
+    }
+
+    curTimeNs = Clock_ReadNanoSec();
+    event.elapsedNs = (curTimeNs > event.startNs) ? (curTimeNs - event.startNs) : 0;
+
+    if ((0 == event.budgetMs) || (event.elapsedNs <= ((cU64_t)event.budgetMs * NANO_SECONDS_PER_MILLI_SECOND)))
+    {
+        return;
+    }
+
+    /* Reported run is still going on (or is published again after a nested run), only its run time grows */
+    pReportedEvent = findReportedEvent(currentRun);
+    if (NULL != pReportedEvent)
+    {
+        MUTEX_LOCK(gWatchdogMutex);
+        pReportedEvent->elapsedNs = event.elapsedNs;
+        MUTEX_UNLOCK(gWatchdogMutex);
+        return;
+    }
+
+    if (c_TRUE == gConfig.captureStack)
+    {
+        sampleLoopStack(&event);
+    }
+
+    MUTEX_LOCK(gWatchdogMutex);
+    gEvents[gEventCnt % SCHEDULER_WATCHDOG_EVENTS_MAX] = event;
+    gEventRuns[gEventCnt % SCHEDULER_WATCHDOG_EVENTS_MAX] = currentRun;
+    gEventCnt++;
+    gStats.overruns++;
+    gStats.stackSamples += (0 != event.frameCnt) ? 1 : 0;
+    MUTEX_UNLOCK(gWatchdogMutex);
+
+    ppSymbols = backtrace_symbols((void *const *)&event.function, 1);
+    WPRINT("callback over budget: [function=%s], [ctx=%p], [elapsed=%llu us], [budget=%u ms]",
+           ((NULL != ppSymbols) && (NULL != event.function)) ? ppSymbols[0] : "unknown", event.ctx,
+           (unsigned long long)(event.elapsedNs / 1000), event.budgetMs);
+    free(ppSymbols);
+
+    if (0 != event.frameCnt)
+    {
+        backtrace_symbols_fd(event.frames, (int)event.frameCnt, STDERR_FILENO);
+    }
+
+    if (NULL != gConfig.onOverrun)
+    {
+        (*gConfig.onOverrun)(&event);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Take stack sample of loop thread
+ * @param pEvent - Overrun to which frames are added
+ */
+static void sampleLoopStack(SchedulerWatchdogEvent_t *pEvent)
+{
+    struct timespec pollTime = {0, 100000};
+    cU64_t waitedNs = 0;
+
+    __atomic_store_n(&gSampleDoneF, c_FALSE, __ATOMIC_RELAXED);
+
+    if (0 != pthread_kill(gLoopThread, WATCHDOG_STACK_SIGNAL))
+    {
+        return;
+    }
+
+    while ((c_FALSE == __atomic_load_n(&gSampleDoneF, __ATOMIC_ACQUIRE)) && (waitedNs < WATCHDOG_STACK_TIMEOUT_NS))
+    {
+        nanosleep(&pollTime, NULL);
+        waitedNs += (cU64_t)pollTime.tv_nsec;
+    }
+
+    if (c_TRUE == __atomic_load_n(&gSampleDoneF, __ATOMIC_ACQUIRE))
+    {
+        pEvent->frameCnt = (cU32_t)gSampleFrameCnt;
+        memcpy(pEvent->frames, gSampleFrames, sizeof(pEvent->frames));
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Capture frames of interrupted loop thread
+ * @param sig - Signal number
+ */
+static void stackSignalHandler(int sig)
+{
+    int savedErrno = errno;
+
+    (void)sig;
+
+    gSampleFrameCnt = backtrace(gSampleFrames, SCHEDULER_WATCHDOG_FRAMES_MAX);
+    __atomic_store_n(&gSampleDoneF, c_TRUE, __ATOMIC_RELEASE);
+
+    errno = savedErrno;
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ * @file    schedulerWatchdog.h
+ * @author  Kshitij Mistry
+ * @brief   Watchdog of super loop callbacks header file.
+ *
+ * This header file defines watchdog which detects hung or over-budget task and timer callbacks.
+ * While watchdog runs, slot of a callback is resolved when task is registered or timer is started
+ * (callbacks registered before watchdog was started get theirs once it starts), and before the
+ * callback runs, loop thread publishes the slot and start time with one atomic store.
+ * Monitor thread checks the published run periodically and reports it once it exceeds the budget
+ * of its callback, optionally along with a stack sample of the loop thread.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Maximum number of distinct callbacks tracked by watchdog at a time */
+#define SCHEDULER_WATCHDOG_SLOTS_MAX    (32)
+
+/** Slot of callback which is not tracked, its runs are checked against default budget */
+#define SCHEDULER_WATCHDOG_SLOT_NONE    (0xFF)
+
+/** Maximum number of frames in stack sample */
+#define SCHEDULER_WATCHDOG_FRAMES_MAX   (16)
+
+/** Number of recent overruns kept */
+#define SCHEDULER_WATCHDOG_EVENTS_MAX   (8)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Callback run which exceeded its budget
+ */
+typedef struct
+{
+    /** Address of task function or timer callback */
+    const void *function;
+
+    /** Application context of callback */
+    void *ctx;
+
+    /** Monotonic time at which run started in nanosec */
+    cU64_t startNs;
+
+    /** Run time when last seen by monitor in nanosec, run may have continued after it */
+    cU64_t elapsedNs;
+
+    /** Budget of callback in millisec */
+    cU32_t budgetMs;
+
+    /** Number of frames in stack sample, 0 when not taken */
+    cU32_t frameCnt;
+
+    /** Return addresses of loop thread at the time of overrun, innermost first */
+    void *frames[SCHEDULER_WATCHDOG_FRAMES_MAX];
+
+}SchedulerWatchdogEvent_t;
+
+/**
+ * @brief   Watchdog configuration
+ */
+typedef struct
+{
+    /** Period of monitor thread checks in millisec */
+    cU32_t checkIntervalMs;
+
+    /** Budget of callbacks without declared budget in millisec, 0 to check declared budgets only */
+    cU32_t defaultBudgetMs;
+
+    /** Take stack sample of loop thread when overrun is detected (signal to loop thread) */
+    cBool captureStack;
+
+    /** Called on monitor thread for every overrun, may be NULL */
+    void (*onOverrun)(const SchedulerWatchdogEvent_t *pEvent);
+
+}SchedulerWatchdogConfig_t;
+
+/**
+ * @brief   Watchdog statistics
+ */
+typedef struct
+{
+    /** Number of monitor checks */
+    cU64_t checks;
+
+    /** Number of runs which exceeded budget */
+    cU64_t overruns;
+
+    /** Number of stack samples taken */
+    cU64_t stackSamples;
+
+    /** Number of slot requests which failed because slots were full */
+    cU64_t untracked;
+
+}SchedulerWatchdogStats_t;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e SchedulerWatchdog_Start(const SchedulerWatchdogConfig_t *pConfig);
+
+void SchedulerWatchdog_Stop(void);
+
+cBool SchedulerWatchdog_IsActive(void);
+
+cU32_t SchedulerWatchdog_GetStartCount(void);
+
+cStatus_e SchedulerWatchdog_SetBudget(const void *function, void *ctx, cU32_t budgetMs);
+
+cU8_t SchedulerWatchdog_AcquireSlot(const void *function, void *ctx);
+
+void SchedulerWatchdog_ReleaseSlot(cU8_t slotId);
+
+cU64_t SchedulerWatchdog_Begin(cU8_t slotId, cU64_t startNs);
+
+void SchedulerWatchdog_End(cU64_t token);
+
+cU32_t SchedulerWatchdog_GetEvents(SchedulerWatchdogEvent_t *pEvents, cU32_t maxCnt);
+
+void SchedulerWatchdog_GetStats(SchedulerWatchdogStats_t *pStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,204 @@
+/*****************************************************************************
+ * @file    staticScheduler.h
+ * @author  Kshitij Mistry
+ * @brief   Compile time configured task scheduler.
+ *
+ * This header file generates a task scheduler from a task table which is declared at compile time.
+ * It is meant for fixed function firmware where the task set never changes at runtime. Each task gets
+ * its own tick counter with threshold derived at compile time and the dispatcher calls every task
+ * function directly, so there is no registration, no indirect call and no runtime division.
+ *
+ * Declare the task table and timer resolution before including this header (in exactly one file):
+ *
+ *      #define STATIC_SCHEDULER_RESOLUTION_MS  10
+ *      #define STATIC_SCHEDULER_TASKS(TASK)    \
+ *          TASK(ReadSensors,   10)             \
+ *          TASK(PublishData,   100)
+ *      #include "staticScheduler.h"
+ *
+ * Task period is in millisec and it must be a non zero multiple of STATIC_SCHEDULER_RESOLUTION_MS,
+ * otherwise compilation fails. Task functions must have "void name(void)" prototype.
+ *
+ *****************************************************************************/
+#pragma once
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_def.h"
+#include "common_utils.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+#ifndef STATIC_SCHEDULER_RESOLUTION_MS
+#error "STATIC_SCHEDULER_RESOLUTION_MS must be defined before including staticScheduler.h"
+#endif
+
+#ifndef STATIC_SCHEDULER_TASKS
+#error "STATIC_SCHEDULER_TASKS(TASK) table must be defined before including staticScheduler.h"
+#endif
+
+#ifdef __cplusplus
+#define STATIC_SCHEDULER_ASSERT(cond, msg)  static_assert(cond, msg)
+#else
+#define STATIC_SCHEDULER_ASSERT(cond, msg)  _Static_assert(cond, msg)
+#endif
+
+/** Timer resolution in nano sec */
+#define STATIC_SCHEDULER_RESOLUTION_NS      (((cI64_t)STATIC_SCHEDULER_RESOLUTION_MS) * NANO_SECONDS_PER_MILLI_SECOND)
+
+/** Minimum sleep of application super loop in ns */
+#define STATIC_SCHEDULER_BASE_SLEEP_NS      (1000000LL)
+
+/** Number of timer ticks after which task is released */
+#define STATIC_SCHEDULER_TICKS(periodMs)    ((periodMs) / STATIC_SCHEDULER_RESOLUTION_MS)
+
+STATIC_SCHEDULER_ASSERT((STATIC_SCHEDULER_RESOLUTION_MS > 0) && (STATIC_SCHEDULER_RESOLUTION_MS < 1000),
+                        "static scheduler resolution must be between 1 and 999 millisec");
+
+/*****************************************************************************
+ * TASK TABLE EXPANSION
+ *****************************************************************************/
+/* Declare task functions so that dispatcher can call them directly */
+#define STATIC_TASK_DECLARE(name, periodMs) void name(void);
+STATIC_SCHEDULER_TASKS(STATIC_TASK_DECLARE)
+#undef STATIC_TASK_DECLARE
+
+/* Reject period which can not be derived from timer resolution */
+#define STATIC_TASK_VALIDATE(name, periodMs)                                                                \
+    STATIC_SCHEDULER_ASSERT(((periodMs) >= STATIC_SCHEDULER_RESOLUTION_MS),                                 \
+                            "period of task " #name " is less than static scheduler resolution");           \
+    STATIC_SCHEDULER_ASSERT((((periodMs) % STATIC_SCHEDULER_RESOLUTION_MS) == 0),                           \
+                            "period of task " #name " is not multiple of static scheduler resolution");
+STATIC_SCHEDULER_TASKS(STATIC_TASK_VALIDATE)
+#undef STATIC_TASK_VALIDATE
+
+/**
+ * @brief	Tick counter of every task in the static task table
+ */
+typedef struct
+{
+#define STATIC_TASK_TICK_CNT(name, periodMs) cU32_t name;
+    STATIC_SCHEDULER_TASKS(STATIC_TASK_TICK_CNT)
+#undef STATIC_TASK_TICK_CNT
+
+}StaticTaskTicks_t;
+
+/**
+ * @brief	Ready to run flag of every task in the static task table
+ */
+typedef struct
+{
+#define STATIC_TASK_READY(name, periodMs) cBool name;
+    STATIC_SCHEDULER_TASKS(STATIC_TASK_READY)
+#undef STATIC_TASK_READY
+
+}StaticTaskReady_t;
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Tick counters of tasks */
+static StaticTaskTicks_t gStaticTaskTicks;
+
+/** Ready to run flags of tasks */
+static StaticTaskReady_t gStaticTaskReady;
+
+/** Monotonic clock reference time */
+static cU64_t gStaticLastMonotonicTimeInNanoSec = 0;
+
+/** Elapsed nano sec Since Update Tick called Last */
+static cU64_t gStaticElapsedNanoSec = 0;
+
+/** Time reference from beginning of caller super loop */
+static cI64_t gStaticBeginTime = 0;
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that reset all task tick counts and saves start point
+ */
+static inline void StaticScheduler_Reset(void)
+{
+#define STATIC_TASK_RESET(name, periodMs) gStaticTaskTicks.name = 0; gStaticTaskReady.name = c_FALSE;
+    STATIC_SCHEDULER_TASKS(STATIC_TASK_RESET)
+#undef STATIC_TASK_RESET
+
+    gStaticBeginTime = (cI64_t)Utils_GetMonotonicTimeInNanoSec();
+    gStaticLastMonotonicTimeInNanoSec = (cU64_t)gStaticBeginTime;
+    gStaticElapsedNanoSec = 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that gets the the time and marks tasks whose period is elapsed ready to run
+ */
+static inline void StaticScheduler_UpdateTick(void)
+{
+    cU64_t curMonotonicTimeInNanSec = Utils_GetMonotonicTimeInNanoSec();
+
+    /* Update elapsed nano seconds */
+    gStaticElapsedNanoSec += (curMonotonicTimeInNanSec - gStaticLastMonotonicTimeInNanoSec);
+    gStaticLastMonotonicTimeInNanoSec = curMonotonicTimeInNanSec;
+
+    while (gStaticElapsedNanoSec >= (cU64_t)STATIC_SCHEDULER_RESOLUTION_NS)
+    {
+        gStaticElapsedNanoSec -= (cU64_t)STATIC_SCHEDULER_RESOLUTION_NS;
+
+        /* Threshold of every task is compile time constant */
+#define STATIC_TASK_TICK(name, periodMs)                                        \
+        if (++gStaticTaskTicks.name >= STATIC_SCHEDULER_TICKS(periodMs))        \
+        {                                                                       \
+            gStaticTaskTicks.name = 0;                                          \
+            gStaticTaskReady.name = c_TRUE;                                     \
+        }
+        STATIC_SCHEDULER_TASKS(STATIC_TASK_TICK)
+#undef STATIC_TASK_TICK
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief This function run all tasks that are ready to run in the order of task table
+ */
+static inline void StaticScheduler_ExecuteTasksReadyToRun(void)
+{
+#define STATIC_TASK_DISPATCH(name, periodMs)                                    \
+    if (c_TRUE == gStaticTaskReady.name)                                        \
+    {                                                                           \
+        gStaticTaskReady.name = c_FALSE;                                        \
+        name();                                                                 \
+    }
+    STATIC_SCHEDULER_TASKS(STATIC_TASK_DISPATCH)
+#undef STATIC_TASK_DISPATCH
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Function that calculates the dynamic sleep time
+ * @return Sleep time in nanoseconds
+ */
+static inline cI64_t StaticScheduler_GetDynamicSleep(void)
+{
+    cI64_t diffNs;
+
+    /* Add the nanoseconds of timer tick resolution to derive the Sleep */
+    gStaticBeginTime += STATIC_SCHEDULER_RESOLUTION_NS;
+
+    /* Get the Difference */
+    diffNs = gStaticBeginTime - (cI64_t)Utils_GetMonotonicTimeInNanoSec();
+    if (diffNs > 0)
+    {
+        return (diffNs);
+    }
+
+    /* If we are running late then sleep for minimum time only to avoid 100% CPU usage */
+    return (STATIC_SCHEDULER_BASE_SLEEP_NS);
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
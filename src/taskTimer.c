@@ -5,19 +5,29 @@
  *
  * This file implements the task timer utility, which allows for the registration,
  * deregistration, and execution of timers that expire after a specified duration.
+ * Every node knows the link which points to it, so start and stop are O(1) and can be called
+ * from expiry callbacks while the list is being walked. Group keeps only counts and a generation,
+ * group stop bumps the generation and its running members are unlinked by next tick, so timer
+ * node carries just a group pointer.
  *
  *****************************************************************************/
 
 /*****************************************************************************
  * INCLUDES
  *****************************************************************************/
+#include "common_clock.h"
+#include "common_probe.h"
+#include "loopStats.h"
+#include "schedulerRecord.h"
+#include "schedulerWatchdog.h"
 #include "taskTimer.h"
+#include <string.h>
 
 /*****************************************************************************
  * MACROS
  *****************************************************************************/
-/** Timer tick in miliseconds */
-#define TASK_TIMER_TICK_RESOLUTION_IN_MS (100)
+/** Watchdog slot of timer started while watchdog was not running, out of slot range so release ignores it */
+#define TASK_TIMER_WATCHDOG_SLOT_UNRESOLVED (0xFE)
 
 /*****************************************************************************
  * VARIABLES
@@ -25,6 +35,39 @@
 /** Task timer linked list head */
 static TaskTimer_t *taskTimerHead = NULL;
 
+/** Number of ticks provided to task timer module since init */
+static cU64_t taskTimerTickCnt = 0;
+
+/** Number of timer expiries aligned on already existing expiry tick */
+static cU64_t taskTimerCoalescedCnt = 0;
+
+/** Number of running timers */
+static cU32_t taskTimerActiveCnt = 0;
+
+/** Id of timer list, changed on init so that nodes of older list are not treated as running */
+static cU32_t taskTimerListId = 1;
+
+/** Node which expiry pass visits next, NULL when no pass is in progress */
+static TaskTimer_t *taskTimerNextNode = NULL;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+static cU32_t alignExpiryTicks(TaskTimer_t *taskTimer, cU32_t ticks, cU32_t slackTicks);
+
+static cBool isTimerLinked(const TaskTimer_t *taskTimer);
+
+static cBool isTimerInList(const TaskTimer_t *taskTimer);
+
+static void linkTimer(TaskTimer_t *taskTimer);
+
+static cBool unlinkTimer(TaskTimer_t *taskTimer);
+
+static cBool isTimerStoppedByGroup(const TaskTimer_t *taskTimer);
+
+static cBool isTimerPaused(const TaskTimer_t *taskTimer);
+
 /*****************************************************************************
  * FUNCTION DEFINATIONS
  *****************************************************************************/
@@ -34,7 +77,29 @@ static TaskTimer_t *taskTimerHead = NULL;
  */
 void TaskTimer_Init(void)
 {
+    TaskTimer_t *curNode;
+
+    /* Timers of older list are dropped, their watchdog slots are given back */
+    for (curNode = taskTimerHead; curNode != NULL; curNode = curNode->next)
+    {
+        SchedulerWatchdog_ReleaseSlot((cU8_t)curNode->watchdogSlot);
+
+        if ((curNode->group != NULL) && (c_FALSE == isTimerStoppedByGroup(curNode)))
+        {
+            curNode->group->runningCnt--;
+        }
+    }
+
     taskTimerHead = NULL;
+    taskTimerTickCnt = 0;
+    taskTimerCoalescedCnt = 0;
+    taskTimerActiveCnt = 0;
+    taskTimerNextNode = NULL;
+
+    if (0 == ++taskTimerListId)
+    {
+        taskTimerListId = 1;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -43,19 +108,24 @@ void TaskTimer_Init(void)
  */
 void TaskTimer_Exit(void)
 {
-    if (taskTimerHead == NULL)
+    while (taskTimerHead != NULL)
     {
-        return;
+        /* Stop single shot timer */
+        TaskTimer_Stop(taskTimerHead);
     }
+}
 
-    TaskTimer_t *curNode = taskTimerHead;
-    while (curNode != NULL)
+//----------------------------------------------------------------------------
+/**
+ * @brief Zero timer node before its first start, same as TASK_TIMER_INIT
+ * @param taskTimer - Timer handle
+ * @note Node of static storage is already zeroed, running node must not be initialized again
+ */
+void TaskTimer_InitNode(TaskTimer_t *taskTimer)
+{
+    if (taskTimer != NULL)
     {
-        TaskTimer_t *prevNode = curNode;
-        curNode = curNode->next;
-
-        /* Stop single shot timer */
-        TaskTimer_Stop(prevNode);
+        memset(taskTimer, 0, sizeof(*taskTimer));
     }
 }
 
@@ -67,9 +137,30 @@ void TaskTimer_Exit(void)
  * @param callback - callback routine
  * @param userData - Pointer to user data
  * @return Returns true if started successfully, false otherwise
+ * @note Node must be zeroed (TASK_TIMER_INIT or TaskTimer_InitNode) before it is started first time
  * @note It timer is already inserted in the list, it will not be inserted again but number of ticks will get overwrite
+ * @note It can be called from expiry callback, timer started there is not ticked by the expiry pass in progress
  */
 cBool TaskTimer_Start(TaskTimer_t *taskTimer, cU32_t expireAfterMs, void (*callback)(void *userData), void *userData)
+{
+    return TaskTimer_StartWithSlack(taskTimer, expireAfterMs, 0, callback, userData);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Insert timer in the timer list head which may expire late by given slack
+ * @param taskTimer - Timer Handle
+ * @param expireAfterMs - Time in milliseconds after which timer expires
+ * @param slackMs - Tolerated expiry delay in milliseconds
+ * @param callback - callback routine
+ * @param userData - Pointer to user data
+ * @return Returns true if started successfully, false otherwise
+ * @note Node must be zeroed (TASK_TIMER_INIT or TaskTimer_InitNode) before it is started first time
+ * @note Expiry is aligned on tick of other running timer which falls in slack window, otherwise it is
+ *       rounded up on power of two tick boundary within slack window so that future timers can share it.
+ */
+cBool TaskTimer_StartWithSlack(TaskTimer_t *taskTimer, cU32_t expireAfterMs, cU32_t slackMs,
+                               void (*callback)(void *userData), void *userData)
 {
     /* Validate input params */
     if ((taskTimer == NULL) || (callback == NULL))
@@ -77,132 +168,520 @@ cBool TaskTimer_Start(TaskTimer_t *taskTimer, cU32_t expireAfterMs, void (*callb
         return c_FALSE;
     }
 
+    /* Running timer is moved to list head, expiry pass in progress has already visited or skips it */
+    if (c_TRUE == unlinkTimer(taskTimer))
+    {
+        SchedulerWatchdog_ReleaseSlot((cU8_t)taskTimer->watchdogSlot);
+    }
+
     /* Derive ticks to expire timer */
-    taskTimer->ticks = (expireAfterMs/TASK_TIMER_TICK_RESOLUTION_IN_MS);
+    taskTimer->slackTicks = (slackMs/TASK_TIMER_TICK_RESOLUTION_IN_MS);
+    taskTimer->ticks = alignExpiryTicks(taskTimer, (expireAfterMs/TASK_TIMER_TICK_RESOLUTION_IN_MS), taskTimer->slackTicks);
 
     /* Store application data and callback */
     taskTimer->userData = userData;
     taskTimer->callback = callback;
+    taskTimer->watchdogSlot = (c_TRUE == SchedulerWatchdog_IsActive())
+                              ? SchedulerWatchdog_AcquireSlot((const void *)callback, userData)
+                              : TASK_TIMER_WATCHDOG_SLOT_UNRESOLVED;
+
+    SchedulerRecord_Event(SCHEDULER_RECORD_TIMER_START, taskTimer, NULL, expireAfterMs, 0);
+    SCHEDULER_PROBE3(timer__start, taskTimer, callback, expireAfterMs);
 
     /* It will add the task at beginning of the list */
+    linkTimer(taskTimer);
+    return (c_TRUE);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Remove timer from the lists
+ * @param taskTimer - Timer handle
+ * @note It can be called from expiry callback for any timer, including the one expiry pass visits next
+ */
+void TaskTimer_Stop(TaskTimer_t *taskTimer)
+{
+    if (c_TRUE == unlinkTimer(taskTimer))
+    {
+        SchedulerWatchdog_ReleaseSlot((cU8_t)taskTimer->watchdogSlot);
+        SchedulerRecord_Event(SCHEDULER_RECORD_TIMER_STOP, taskTimer, NULL, 0, 0);
+        SCHEDULER_PROBE2(timer__stop, taskTimer, taskTimer->callback);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Decrement number of ticks of each timer in the list
+ */
+void TaskTimer_Tick(void)
+{
     if (taskTimerHead == NULL)
     {
-        taskTimerHead = taskTimer;
-        taskTimer->next = NULL;
+        return;
     }
-    else
+
+    taskTimerTickCnt++;
+
+    if (0 != (LoopStats_GetEnabled() & LOOP_STATS_PHASES))
     {
-        if (c_TRUE == TaskTimer_IsRunning(taskTimer))
+        LoopStats_PhaseBegin(LOOP_PHASE_TIMER_EXPIRY, Clock_ReadNanoSec());
+    }
+
+    TaskTimer_t *curNode = taskTimerHead;
+    while (curNode != NULL)
+    {
+        /* Callbacks may stop the node which is visited next, then pass continues after it */
+        taskTimerNextNode = curNode->next;
+
+        /* Member stopped by its group is unlinked now */
+        if (c_TRUE == isTimerStoppedByGroup(curNode))
+        {
+            unlinkTimer(curNode);
+            curNode = taskTimerNextNode;
+            continue;
+        }
+
+        /* Members of paused group keep their remaining ticks */
+        if (c_TRUE == isTimerPaused(curNode))
+        {
+            curNode = taskTimerNextNode;
+            continue;
+        }
+
+        curNode->ticks--;
+        if (curNode->ticks)
+        {
+            curNode = taskTimerNextNode;
+            continue;
+        }
+
+        TaskTimer_t *expireNode = curNode;
+        cU8_t watchdogSlot = (cU8_t)expireNode->watchdogSlot;
+
+        /* Stop single shot timer, its watchdog slot is given back once callback has returned */
+        unlinkTimer(expireNode);
+
+        /* Timer started while watchdog was not running gets slot for this run only */
+        if (TASK_TIMER_WATCHDOG_SLOT_UNRESOLVED == watchdogSlot)
+        {
+            watchdogSlot = SchedulerWatchdog_AcquireSlot((const void *)expireNode->callback, expireNode->userData);
+        }
+
+        /* Execute timer expiry callback */
+        cU64_t watchdogToken = SchedulerWatchdog_Begin(watchdogSlot, 0);
+        SCHEDULER_PROBE3(timer__expire, expireNode, expireNode->callback, expireNode->userData);
+
+        if (c_TRUE == SchedulerRecord_IsActive())
         {
-            return (c_TRUE);
+            cU64_t expiryTimeNs = Clock_ReadNanoSec();
+
+            (*expireNode->callback)(expireNode->userData);
+            SchedulerRecord_Event(SCHEDULER_RECORD_TIMER_EXPIRY, expireNode, NULL,
+                                  (cU32_t)(Clock_ReadNanoSec() - expiryTimeNs), expiryTimeNs);
+        }
+        else
+        {
+            (*expireNode->callback)(expireNode->userData);
         }
 
-        taskTimer->next = taskTimerHead;
-        taskTimerHead = taskTimer;
+        SchedulerWatchdog_End(watchdogToken);
+        SchedulerWatchdog_ReleaseSlot(watchdogSlot);
+        SCHEDULER_PROBE1(timer__expire__end, expireNode);
+
+        curNode = taskTimerNextNode;
     }
 
-    return (c_TRUE);
+    taskTimerNextNode = NULL;
+
+    if (0 != (LoopStats_GetEnabled() & LOOP_STATS_PHASES))
+    {
+        LoopStats_PhaseEnd(Clock_ReadNanoSec());
+    }
 }
 
 //----------------------------------------------------------------------------
 /**
- * @brief Remove timer from the lists
+ * @brief Check if timer is running or not
  * @param taskTimer - Timer handle
+ * @return Returns true if timer is running, false otherwise
  */
-void TaskTimer_Stop(TaskTimer_t *taskTimer)
+cBool TaskTimer_IsRunning(const TaskTimer_t *taskTimer)
 {
-    if (taskTimerHead == NULL)
+    return isTimerLinked(taskTimer);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get number of timer expiries which were aligned on expiry tick of other timer
+ * @return Number of coalesced timer expiries
+ */
+cU64_t TaskTimer_GetCoalescedCount(void)
+{
+    return (taskTimerCoalescedCnt);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get number of running timers
+ * @return Number of timers in the list
+ */
+cU32_t TaskTimer_GetActiveCount(void)
+{
+    return (taskTimerActiveCnt);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Initialize empty timer group
+ * @param group - Group handle
+ */
+void TaskTimer_GroupInit(TaskTimerGroup_t *group)
+{
+    if (group == NULL)
+    {
+        return;
+    }
+
+    group->memberCnt = 0;
+    group->runningCnt = 0;
+    group->generation = 0;
+    group->paused = c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Attach timer to group, timer attached to other group is moved
+ * @param group - Group handle
+ * @param taskTimer - Timer handle, running or not
+ * @return Returns true if attached successfully, false otherwise
+ * @note Membership does not change when timer is started, stopped or expires, group must outlive its members
+ */
+cBool TaskTimer_GroupAdd(TaskTimerGroup_t *group, TaskTimer_t *taskTimer)
+{
+    if ((group == NULL) || (taskTimer == NULL))
+    {
+        return c_FALSE;
+    }
+
+    if (taskTimer->group == group)
+    {
+        return c_TRUE;
+    }
+
+    TaskTimer_GroupRemove(taskTimer);
+
+    if (c_TRUE == isTimerLinked(taskTimer))
+    {
+        group->runningCnt++;
+    }
+
+    group->memberCnt++;
+    taskTimer->group = group;
+    taskTimer->groupGen = group->generation;
+    return c_TRUE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Detach timer from its group, timer keeps running if it is running
+ * @param taskTimer - Timer handle
+ */
+void TaskTimer_GroupRemove(TaskTimer_t *taskTimer)
+{
+    if ((taskTimer == NULL) || (taskTimer->group == NULL))
     {
         return;
     }
 
-    if (taskTimerHead == taskTimer)
+    /* Member stopped by group is unlinked before it loses the generation which stopped it */
+    if (c_TRUE == isTimerStoppedByGroup(taskTimer))
+    {
+        unlinkTimer(taskTimer);
+    }
+    else if (c_TRUE == isTimerLinked(taskTimer))
+    {
+        taskTimer->group->runningCnt--;
+    }
+
+    taskTimer->group->memberCnt--;
+    taskTimer->group = NULL;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Stop all running members of group, members stay attached
+ * @param group - Group handle
+ * @return Number of timers stopped
+ * @note It is O(1), members are not running from now on and are unlinked by next tick (their stop
+ *       is recorded then). It can be called from expiry callback, including the one of a group member
+ */
+cU32_t TaskTimer_GroupStop(TaskTimerGroup_t *group)
+{
+    cU32_t stoppedCnt;
+
+    if ((group == NULL) || (0 == group->runningCnt))
+    {
+        return (0);
+    }
+
+    stoppedCnt = group->runningCnt;
+    group->generation++;
+    group->runningCnt = 0;
+    taskTimerActiveCnt -= stoppedCnt;
+
+    return (stoppedCnt);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Pause group, its running members do not count down till group is resumed
+ * @param group - Group handle
+ * @note It is O(1), members started while group is paused are paused as well
+ */
+void TaskTimer_GroupPause(TaskTimerGroup_t *group)
+{
+    if (group != NULL)
+    {
+        group->paused = c_TRUE;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Resume paused group, members continue with ticks they had left when paused
+ * @param group - Group handle
+ */
+void TaskTimer_GroupResume(TaskTimerGroup_t *group)
+{
+    if (group != NULL)
+    {
+        group->paused = c_FALSE;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Move expiry of all running members of group by same amount of time
+ * @param group - Group handle
+ * @param shiftMs - Time in milliseconds to postpone expiries by, negative to advance them
+ * @return Number of timers shifted
+ * @note It walks running timers once, member advanced past its expiry expires on next tick
+ */
+cU32_t TaskTimer_GroupShift(TaskTimerGroup_t *group, cI32_t shiftMs)
+{
+    TaskTimer_t *curNode;
+    cI64_t ticks;
+    cU32_t shiftedCnt = 0;
+
+    if ((group == NULL) || (0 == group->runningCnt))
     {
-        taskTimerHead = taskTimerHead->next;
-        taskTimer->next = NULL;
+        return (0);
     }
-    else
+
+    for (curNode = taskTimerHead; curNode != NULL; curNode = curNode->next)
     {
-        TaskTimer_t *prevNode = taskTimerHead;
-        TaskTimer_t *curNode = taskTimerHead->next;
+        if ((curNode->group != group) || (c_TRUE == isTimerStoppedByGroup(curNode)))
+        {
+            continue;
+        }
 
-        while (curNode != NULL)
+        ticks = (cI64_t)curNode->ticks + (shiftMs / TASK_TIMER_TICK_RESOLUTION_IN_MS);
+        if (ticks < 1)
+        {
+            ticks = 1;
+        }
+        else if (ticks > UINT32_MAX)
         {
-            if (curNode == taskTimer)
-            {
-                prevNode->next = curNode->next;
-                return;
-            }
-
-            prevNode = curNode;
-            curNode = curNode->next;
+            ticks = UINT32_MAX;
         }
+
+        curNode->ticks = (cU32_t)ticks;
+        shiftedCnt++;
     }
+
+    return (shiftedCnt);
 }
 
 //----------------------------------------------------------------------------
 /**
- * @brief Decrement number of ticks of each timer in the list
+ * @brief Derive expiry ticks of timer within its slack window
+ * @param taskTimer - Timer handle which is being started
+ * @param ticks - Earliest expiry ticks
+ * @param slackTicks - Tolerated delay in ticks
+ * @return Aligned expiry ticks
  */
-void TaskTimer_Tick(void)
+static cU32_t alignExpiryTicks(TaskTimer_t *taskTimer, cU32_t ticks, cU32_t slackTicks)
 {
-    if (taskTimerHead == NULL)
+    TaskTimer_t *curNode;
+    cU32_t alignedTicks = UINT32_MAX;
+    cU64_t granularity = 1;
+    cU64_t expiryTick;
+
+    if (0 == slackTicks)
     {
-        return;
+        return (ticks);
     }
 
-    TaskTimer_t *curNode = taskTimerHead;
-    while (curNode != NULL)
+    /* Join the earliest expiry of other running timer which falls in our slack window */
+    for (curNode = taskTimerHead; curNode != NULL; curNode = curNode->next)
     {
-        curNode->ticks--;
-        if (curNode->ticks)
+        if ((curNode == taskTimer) || (curNode->ticks < ticks) || ((curNode->ticks - ticks) > slackTicks)
+                || (c_TRUE == isTimerStoppedByGroup(curNode)) || (c_TRUE == isTimerPaused(curNode)))
         {
-            curNode = curNode->next;
             continue;
         }
 
-        TaskTimer_t *expireNode = curNode;
-        curNode = curNode->next;
+        if (curNode->ticks < alignedTicks)
+        {
+            alignedTicks = curNode->ticks;
+        }
+    }
 
-        /* Stop single shot timer */
-        TaskTimer_Stop(expireNode);
+    if (UINT32_MAX != alignedTicks)
+    {
+        taskTimerCoalescedCnt++;
+        return (alignedTicks);
+    }
 
-        /* Execute timer expiry callback */
-        (*expireNode->callback)(expireNode->userData);
+    /* Round up absolute expiry tick to largest power of two which does not exceed slack window */
+    while ((granularity << 1) <= ((cU64_t)slackTicks + 1))
+    {
+        granularity <<= 1;
     }
+
+    expiryTick = taskTimerTickCnt + ticks;
+    expiryTick = ((expiryTick + granularity - 1) / granularity) * granularity;
+
+    return (cU32_t)(expiryTick - taskTimerTickCnt);
 }
 
 //----------------------------------------------------------------------------
 /**
- * @brief Check if timer is running or not
+ * @brief Check if timer is running, i.e. linked in the list and not stopped by its group
  * @param taskTimer - Timer handle
- * @return Returns true if timer is running, false otherwise
+ * @return Returns true if timer is running
  */
-cBool TaskTimer_IsRunning(TaskTimer_t *taskTimer)
+static cBool isTimerLinked(const TaskTimer_t *taskTimer)
 {
-    TaskTimer_t *nextNode;
+    return ((c_TRUE == isTimerInList(taskTimer)) && (c_FALSE == isTimerStoppedByGroup(taskTimer))) ? c_TRUE : c_FALSE;
+}
 
-    if ((taskTimerHead == NULL) || (taskTimer == NULL))
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if timer node is linked in the list
+ * @param taskTimer - Timer handle
+ * @return Returns true if node is linked
+ * @note Node is zeroed before first use, and link of node is trusted only when node carries id of
+ *       current list, so stopped, expired or new nodes and nodes of list before last init are never
+ *       treated as linked
+ */
+static cBool isTimerInList(const TaskTimer_t *taskTimer)
+{
+    if ((taskTimer == NULL) || (taskTimer->listId != taskTimerListId) || (taskTimer->pprev == NULL))
     {
         return (c_FALSE);
     }
 
-    if (taskTimerHead == taskTimer)
+    return (*taskTimer->pprev == taskTimer) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Link timer at head of the list
+ * @param taskTimer - Timer handle which is not linked
+ */
+static void linkTimer(TaskTimer_t *taskTimer)
+{
+    taskTimer->next = taskTimerHead;
+    taskTimer->pprev = &taskTimerHead;
+
+    if (taskTimerHead != NULL)
     {
-        return (c_TRUE);
+        taskTimerHead->pprev = &taskTimer->next;
     }
 
-    nextNode = taskTimerHead->next;
-    while (nextNode != NULL)
+    taskTimerHead = taskTimer;
+    taskTimer->listId = taskTimerListId;
+    taskTimerActiveCnt++;
+
+    if (taskTimer->group != NULL)
     {
-        if (nextNode == taskTimer)
-        {
-            return (c_TRUE);
-        }
-        nextNode = nextNode->next;
+        taskTimer->groupGen = taskTimer->group->generation;
+        taskTimer->group->runningCnt++;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Unlink timer from the list
+ * @param taskTimer - Timer handle
+ * @return Returns true if timer was running, false if it was not linked or was stopped by its group
+ */
+static cBool unlinkTimer(TaskTimer_t *taskTimer)
+{
+    cBool runningF;
+
+    if (c_FALSE == isTimerInList(taskTimer))
+    {
+        return (c_FALSE);
+    }
+
+    runningF = (c_FALSE == isTimerStoppedByGroup(taskTimer)) ? c_TRUE : c_FALSE;
+
+    /* Expiry pass in progress continues from node after the removed one */
+    if (taskTimer == taskTimerNextNode)
+    {
+        taskTimerNextNode = taskTimer->next;
+    }
+
+    *taskTimer->pprev = taskTimer->next;
+    if (taskTimer->next != NULL)
+    {
+        taskTimer->next->pprev = taskTimer->pprev;
+    }
+
+    taskTimer->next = NULL;
+    taskTimer->pprev = NULL;
+    taskTimer->listId = 0;
+
+    /* Member stopped by its group was already taken out of counts, its stop completes here */
+    if (c_FALSE == runningF)
+    {
+        SchedulerWatchdog_ReleaseSlot((cU8_t)taskTimer->watchdogSlot);
+        SchedulerRecord_Event(SCHEDULER_RECORD_TIMER_STOP, taskTimer, NULL, 0, 0);
+        SCHEDULER_PROBE2(timer__stop, taskTimer, taskTimer->callback);
+        return (c_FALSE);
     }
 
-    return (c_FALSE);
+    taskTimerActiveCnt--;
+    if (taskTimer->group != NULL)
+    {
+        taskTimer->group->runningCnt--;
+    }
+
+    return (c_TRUE);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if running member was stopped by its group
+ * @param taskTimer - Timer handle
+ * @return Returns true if group was stopped after timer was started
+ */
+static cBool isTimerStoppedByGroup(const TaskTimer_t *taskTimer)
+{
+    return ((taskTimer->group != NULL) && (taskTimer->groupGen != taskTimer->group->generation)) ? c_TRUE : c_FALSE;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Check if timer belongs to paused group
+ * @param taskTimer - Timer handle
+ * @return Returns true if timer is paused
+ */
+static cBool isTimerPaused(const TaskTimer_t *taskTimer)
+{
+    return ((taskTimer->group != NULL) && (c_TRUE == taskTimer->group->paused)) ? c_TRUE : c_FALSE;
 }
 
 /*****************************************************************************
@@ -5,15 +5,30 @@
  *
  * This header file defines the task timer utility, which allows for the registration,
  * deregistration, and execution of timers that expire after a specified duration.
+ * Timers which belong together (e.g. all timers of one peer) can be attached to a group, which is
+ * stopped or paused with one O(1) call, or shifted with one pass over running timers.
  *
  *****************************************************************************/
 #pragma once
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*****************************************************************************
  * INCLUDES
  *****************************************************************************/
 #include "common_stddef.h"
 
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Timer tick in miliseconds */
+#define TASK_TIMER_TICK_RESOLUTION_IN_MS (100)
+
+/** Initializer of timer node, node must be zeroed before it is started first time */
+#define TASK_TIMER_INIT {0}
+
 /*****************************************************************************
  * STRUCTURES
  *****************************************************************************/
@@ -28,6 +43,18 @@ typedef struct TaskTimer_t
     /** Timer tick count to be wait for timer expire */
     cU32_t ticks;
 
+    /** Ticks by which timer expiry may be delayed to expire together with other timers */
+    cU32_t slackTicks;
+
+    /** Id of timer list in which node is linked, 0 when timer is not running */
+    cU32_t listId;
+
+    /** Generation of group when timer was started, timer is stopped by its group when they differ */
+    cU32_t groupGen;
+
+    /** Watchdog slot of callback, resolved when timer is started */
+    cU32_t watchdogSlot;
+
     /** Application data */
     void *userData;
 
@@ -37,8 +64,33 @@ typedef struct TaskTimer_t
     /** Reference of next node in the list */
     struct TaskTimer_t *next;
 
+    /** Link which points to this node (list head or next of previous node), for O(1) removal */
+    struct TaskTimer_t **pprev;
+
+    /** Group to which timer is attached, NULL when not attached */
+    struct TaskTimerGroup_t *group;
+
 }TaskTimer_t;
 
+/**
+ * @brief   Group of timers which are stopped, paused or shifted together
+ */
+typedef struct TaskTimerGroup_t
+{
+    /** Number of members */
+    cU32_t memberCnt;
+
+    /** Number of running members */
+    cU32_t runningCnt;
+
+    /** Changed when group is stopped, running members of older generation are unlinked on next tick */
+    cU32_t generation;
+
+    /** Members are not ticked while group is paused */
+    cBool paused;
+
+}TaskTimerGroup_t;
+
 /*****************************************************************************
  * FUNCTION DECLARATIONS
  *****************************************************************************/
@@ -47,13 +99,40 @@ void TaskTimer_Init(void);
 
 void TaskTimer_Exit(void);
 
+void TaskTimer_InitNode(TaskTimer_t *taskTimer);
+
 cBool TaskTimer_Start(TaskTimer_t *taskTimer, cU32_t expireAfterMs, void (*callback)(void *userData), void *userData);
 
+cBool TaskTimer_StartWithSlack(TaskTimer_t *taskTimer, cU32_t expireAfterMs, cU32_t slackMs,
+                               void (*callback)(void *userData), void *userData);
+
 void TaskTimer_Stop(TaskTimer_t *taskTimer);
 
 void TaskTimer_Tick(void);
 
-cBool TaskTimer_IsRunning(TaskTimer_t *taskTimer);
+cBool TaskTimer_IsRunning(const TaskTimer_t *taskTimer);
+
+cU64_t TaskTimer_GetCoalescedCount(void);
+
+cU32_t TaskTimer_GetActiveCount(void);
+
+void TaskTimer_GroupInit(TaskTimerGroup_t *group);
+
+cBool TaskTimer_GroupAdd(TaskTimerGroup_t *group, TaskTimer_t *taskTimer);
+
+void TaskTimer_GroupRemove(TaskTimer_t *taskTimer);
+
+cU32_t TaskTimer_GroupStop(TaskTimerGroup_t *group);
+
+void TaskTimer_GroupPause(TaskTimerGroup_t *group);
+
+void TaskTimer_GroupResume(TaskTimerGroup_t *group);
+
+cU32_t TaskTimer_GroupShift(TaskTimerGroup_t *group, cI32_t shiftMs);
+
+#ifdef __cplusplus
+}
+#endif
 
 /*****************************************************************************
  * @END OF FILE
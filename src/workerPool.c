@@ -0,0 +1,219 @@
+/*****************************************************************************
+ * @file    workerPool.c
+ * @author  Kshitij Mistry
+ * @brief   Fork-join worker thread pool implementation file.
+ *
+ * This file implements worker threads which sleep on a condition variable until WorkerPool_Execute
+ * publishes new work generation. Pool is started and stopped from the loop thread only.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_def.h"
+#include "workerPool.h"
+#include <pthread.h>
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Worker threads */
+static pthread_t gWorkerThreads[WORKER_POOL_THREADS_MAX];
+
+/** Number of running worker threads */
+static cU8_t gWorkerCnt = 0;
+
+/** Protects all pool state below */
+static pthread_mutex_t gPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Signalled when new work is published or pool is stopped */
+static pthread_cond_t gWorkCond = PTHREAD_COND_INITIALIZER;
+
+/** Signalled when last worker finished its work */
+static pthread_cond_t gDoneCond = PTHREAD_COND_INITIALIZER;
+
+/** Generation of published work */
+static cU32_t gWorkGeneration = 0;
+
+/** Published work function */
+static void (*gWork)(void *arg) = NULL;
+
+/** Argument of published work function */
+static void *gWorkArg = NULL;
+
+/** Number of workers which have not finished published work yet */
+static cU8_t gBusyWorkerCnt = 0;
+
+/** Workers should exit */
+static cBool gStopF = c_FALSE;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static void *workerThread(void *arg);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+/**
+ * @brief Start worker threads
+ * @param threadCnt - Number of worker threads, calling thread of WorkerPool_Execute is not counted
+ * @return Error code to indicate success or failure of function
+ */
+cStatus_e WorkerPool_Start(cU8_t threadCnt)
+{
+    cU8_t threadId;
+
+    if ((0 == threadCnt) || (threadCnt > WORKER_POOL_THREADS_MAX))
+    {
+        return (cStatus_INVALID_ARG);
+    }
+
+    if (0 != gWorkerCnt)
+    {
+        return (cStatus_RESOURCE_BUSY);
+    }
+
+    gStopF = c_FALSE;
+
+    for (threadId = 0; threadId < threadCnt; threadId++)
+    {
+        /* Worker gets current generation, so work published before it starts is not missed */
+        if (0 != pthread_create(&gWorkerThreads[threadId], NULL, workerThread, (void *)(uintptr_t)gWorkGeneration))
+        {
+            EPRINT("fail to create worker thread: [id=%d]", threadId);
+            break;
+        }
+
+        gWorkerCnt++;
+    }
+
+    if (gWorkerCnt != threadCnt)
+    {
+        WorkerPool_Stop();
+        return (cStatus_NO_RESOURCE);
+    }
+
+    DPRINT("worker pool started: [threads=%d]", gWorkerCnt);
+    return (cStatus_SUCCESS);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Stop and join all worker threads
+ */
+void WorkerPool_Stop(void)
+{
+    cU8_t threadId;
+
+    MUTEX_LOCK(gPoolMutex);
+    gStopF = c_TRUE;
+    pthread_cond_broadcast(&gWorkCond);
+    MUTEX_UNLOCK(gPoolMutex);
+
+    for (threadId = 0; threadId < gWorkerCnt; threadId++)
+    {
+        pthread_join(gWorkerThreads[threadId], NULL);
+    }
+
+    gWorkerCnt = 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Get number of running worker threads
+ * @return Number of worker threads
+ */
+cU8_t WorkerPool_GetThreadCount(void)
+{
+    return (gWorkerCnt);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Run work function on all workers and calling thread, and wait till all have returned
+ * @param (*work) - Work function
+ * @param arg - Argument passed to work function
+ */
+void WorkerPool_Execute(void (*work)(void *arg), void *arg)
+{
+    if (NULL == work)
+    {
+        return;
+    }
+
+    if (0 != gWorkerCnt)
+    {
+        MUTEX_LOCK(gPoolMutex);
+        gWork = work;
+        gWorkArg = arg;
+        gBusyWorkerCnt = gWorkerCnt;
+        gWorkGeneration++;
+        pthread_cond_broadcast(&gWorkCond);
+        MUTEX_UNLOCK(gPoolMutex);
+    }
+
+    (*work)(arg);
+
+    if (0 != gWorkerCnt)
+    {
+        MUTEX_LOCK(gPoolMutex);
+        while (0 != gBusyWorkerCnt)
+        {
+            pthread_cond_wait(&gDoneCond, &gPoolMutex);
+        }
+        MUTEX_UNLOCK(gPoolMutex);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Worker thread waits for published work and runs it
+ * @param arg - Work generation at the time worker was created
+ * @return NULL
+ */
+static void *workerThread(void *arg)
+{
+    cU32_t doneGeneration;
+    void (*work)(void *arg);
+    void *workArg;
+
+    doneGeneration = (cU32_t)(uintptr_t)arg;
+
+    MUTEX_LOCK(gPoolMutex);
+
+    while (1)
+    {
+        while ((c_FALSE == gStopF) && (doneGeneration == gWorkGeneration))
+        {
+            pthread_cond_wait(&gWorkCond, &gPoolMutex);
+        }
+
+        if (c_TRUE == gStopF)
+        {
+            break;
+        }
+
+        doneGeneration = gWorkGeneration;
+        work = gWork;
+        workArg = gWorkArg;
+        MUTEX_UNLOCK(gPoolMutex);
+
+        (*work)(workArg);
+
+        MUTEX_LOCK(gPoolMutex);
+        if (0 == --gBusyWorkerCnt)
+        {
+            pthread_cond_signal(&gDoneCond);
+        }
+    }
+
+    MUTEX_UNLOCK(gPoolMutex);
+    return (NULL);
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
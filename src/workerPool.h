@@ -0,0 +1,47 @@
+/*****************************************************************************
+ * @file    workerPool.h
+ * @author  Kshitij Mistry
+ * @brief   Fork-join worker thread pool header file.
+ *
+ * This header file defines a small pool of worker threads used by scheduler to execute tasks of
+ * one release in parallel. WorkerPool_Execute runs the same work function on every worker and on
+ * the calling thread, and returns once all of them have returned. Work function itself decides
+ * which piece of work each thread takes.
+ *
+ *****************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_stddef.h"
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Maximum number of worker threads */
+#define WORKER_POOL_THREADS_MAX     (8)
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+
+cStatus_e WorkerPool_Start(cU8_t threadCnt);
+
+void WorkerPool_Stop(void);
+
+cU8_t WorkerPool_GetThreadCount(void);
+
+void WorkerPool_Execute(void (*work)(void *arg), void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
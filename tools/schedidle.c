@@ -0,0 +1,395 @@
+/*****************************************************************************
+ * @file    schedidle.c
+ * @author  Kshitij Mistry
+ * @brief   Idle cost benchmark of the super loop.
+ *
+ * This file implements a benchmark of what a mostly idle scheduler loop costs the host. A sparse
+ * task and timer set is run for a fixed duration with every combination of timer resolution and
+ * sleep strategy, and wakeups per second, voluntary and involuntary context switches and CPU time
+ * of the loop thread (getrusage RUSAGE_THREAD) are printed, so idle efficiency changes can be
+ * measured and regressions caught.
+ *
+ * Usage: schedidle.bin [-d <seconds>] [-t sparse|timers] [-r <ms>[,<ms>...]] [-s <strategy>[,<strategy>...]]
+ *        -d  duration of every run in seconds (default 5)
+ *        -t  task set (default sparse)
+ *        -r  timer resolutions in millisec (default 1,10,100)
+ *        -s  sleep strategies: tick (sleep every tick), coalesce (wakeup coalescing),
+ *            events (coalescing with Scheduler_WaitForEvents, an idle eventfd is watched so
+ *            the readiness backend waits), precision (coalescing with precision wait), default all
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#define _GNU_SOURCE
+#include "common_clock.h"
+#include "common_def.h"
+#include "common_utils.h"
+#include "common_wait.h"
+#include "scheduler.h"
+#include "schedulerIo.h"
+#include "taskTimer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Maximum number of resolutions given to -r */
+#define IDLE_RESOLUTIONS_MAX        (8)
+
+/** Number of timers of timers set */
+#define IDLE_TIMERS_CNT             (100)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Sleep strategy of the loop
+ */
+typedef enum
+{
+    IDLE_STRATEGY_TICK = 0,
+    IDLE_STRATEGY_COALESCE,
+    IDLE_STRATEGY_EVENTS,
+    IDLE_STRATEGY_PRECISION,
+    IDLE_STRATEGY_MAX
+
+}IdleStrategy_e;
+
+/**
+ * @brief   Cost of one run
+ */
+typedef struct
+{
+    /** Super loop wakeups per second */
+    cDouble_t wakeupsPerSec;
+
+    /** Voluntary context switches per second */
+    cDouble_t voluntaryPerSec;
+
+    /** Involuntary context switches per second */
+    cDouble_t involuntaryPerSec;
+
+    /** CPU time of loop thread in percent of one CPU */
+    cDouble_t cpuPercent;
+
+    /** CPU time per wakeup in microsec */
+    cDouble_t cpuPerWakeupUs;
+
+    /** Task and timer callbacks run */
+    cU64_t callbacks;
+
+}IdleCost_t;
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Strategy names */
+static const cChar *gStrategyNames[IDLE_STRATEGY_MAX] = { "tick", "coalesce", "events", "precision" };
+
+/** Timers of timers set */
+static TaskTimer_t gTimers[IDLE_TIMERS_CNT];
+
+/** Task and timer callbacks run in current run */
+static cU64_t gCallbackCnt = 0;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static void runIdle(IdleStrategy_e strategy, cU32_t resolutionMs, cBool timersF, cU32_t durationSec, IdleCost_t *pCost);
+
+static void housekeepingTask(void);
+
+static void reportTask(void);
+
+static void timerExpiry(void *userData);
+
+static void drainWakeFd(cI32_t fd, cU32_t events, void *ctx);
+
+static cU64_t getTimeValNs(const struct timeval *pTime);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+/**
+ * @brief This is main function of idle cost benchmark
+ * @param argc - number of arguments
+ * @param **argv - argument list
+ * @return 0 if successfully exited else -1 on error occurs
+ */
+int main(int argc, char **argv)
+{
+    cI32_t opt;
+    cU32_t durationSec = 5;
+    cU32_t resolutions[IDLE_RESOLUTIONS_MAX] = { 1, 10, 100 };
+    cU32_t resolutionCnt = 3;
+    cU32_t resolutionId;
+    cU32_t strategyId;
+    cBool strategyF[IDLE_STRATEGY_MAX] = { c_TRUE, c_TRUE, c_TRUE, c_TRUE };
+    cBool timersF = c_FALSE;
+    cBool usageF = c_FALSE;
+    cChar *pToken;
+    IdleCost_t cost;
+
+    while (-1 != (opt = getopt(argc, argv, "d:t:r:s:")))
+    {
+        switch (opt)
+        {
+            case 'd': durationSec = (cU32_t)strtoul(optarg, NULL, 10); break;
+
+            case 't':
+                if (0 == strcmp(optarg, "timers"))
+                {
+                    timersF = c_TRUE;
+                }
+                else if (0 != strcmp(optarg, "sparse"))
+                {
+                    usageF = c_TRUE;
+                }
+                break;
+
+            case 'r':
+                resolutionCnt = 0;
+                for (pToken = strtok(optarg, ","); (NULL != pToken) && (resolutionCnt < IDLE_RESOLUTIONS_MAX); pToken = strtok(NULL, ","))
+                {
+                    resolutions[resolutionCnt++] = (cU32_t)strtoul(pToken, NULL, 10);
+                }
+                break;
+
+            case 's':
+                memset(strategyF, 0, sizeof(strategyF));
+                for (pToken = strtok(optarg, ","); NULL != pToken; pToken = strtok(NULL, ","))
+                {
+                    for (strategyId = 0; strategyId < IDLE_STRATEGY_MAX; strategyId++)
+                    {
+                        if (0 == strcmp(pToken, gStrategyNames[strategyId]))
+                        {
+                            strategyF[strategyId] = c_TRUE;
+                        }
+                    }
+                }
+                break;
+
+            default:
+                usageF = c_TRUE;
+                break;
+        }
+    }
+
+    if ((c_TRUE == usageF) || (0 == durationSec) || (0 == resolutionCnt))
+    {
+        fprintf(stderr, "usage: %s [-d <seconds>] [-t sparse|timers] [-r <ms>[,<ms>...]]"
+                        " [-s tick,coalesce,events,precision]\n", argv[0]);
+        return (-1);
+    }
+
+    printf("%-9s %8s %12s %12s %12s %8s %14s %10s\n", "STRATEGY", "RES(ms)", "WAKEUPS/s", "VOL CSW/s",
+           "INVOL CSW/s", "CPU(%)", "CPU/WAKEUP(us)", "CALLBACKS");
+
+    for (resolutionId = 0; resolutionId < resolutionCnt; resolutionId++)
+    {
+        for (strategyId = 0; strategyId < IDLE_STRATEGY_MAX; strategyId++)
+        {
+            if (c_FALSE == strategyF[strategyId])
+            {
+                continue;
+            }
+
+            runIdle((IdleStrategy_e)strategyId, resolutions[resolutionId], timersF, durationSec, &cost);
+
+            printf("%-9s %8u %12.1f %12.1f %12.1f %8.3f %14.2f %10" PRIu64 "\n", gStrategyNames[strategyId],
+                   resolutions[resolutionId], cost.wakeupsPerSec, cost.voluntaryPerSec, cost.involuntaryPerSec,
+                   cost.cpuPercent, cost.cpuPerWakeupUs, cost.callbacks);
+            fflush(stdout);
+        }
+    }
+
+    return (0);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Run task set on super loop and measure its cost
+ * @param strategy - Sleep strategy
+ * @param resolutionMs - Timer resolution in millisec
+ * @param timersF - Run timers set instead of sparse set
+ * @param durationSec - Duration of run in seconds
+ * @param pCost - Measured cost
+ */
+static void runIdle(IdleStrategy_e strategy, cU32_t resolutionMs, cBool timersF, cU32_t durationSec, IdleCost_t *pCost)
+{
+    WaitPrecisionConfig_t waitConfig = { .maxSpinNs = 200000, .maxSpinPercent = 20, .overshootPercentile = 99 };
+    SchedulerLoopStats_t loopStats;
+    struct rusage startUsage;
+    struct rusage endUsage;
+    cU64_t startLoops;
+    cU64_t startTimeNs;
+    cU64_t endTimeNs;
+    cU64_t cpuNs;
+    cDouble_t runSec;
+    cU32_t timerId;
+    cI32_t wakeFd = -1;
+
+    memset(pCost, 0, sizeof(*pCost));
+
+    if (c_FALSE == Scheduler_Init(resolutionMs, NULL))
+    {
+        EPRINT("failed to initialize scheduler: [resolution=%u ms]", resolutionMs);
+        return;
+    }
+
+    /* Without a watched fd Scheduler_WaitForEvents falls back to plain sleep */
+    if (IDLE_STRATEGY_EVENTS == strategy)
+    {
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ((wakeFd < 0) || (cStatus_SUCCESS != Scheduler_WatchFd(wakeFd, SCHEDULER_FD_READABLE, drainWakeFd, NULL)))
+        {
+            EPRINT("failed to watch eventfd, events strategy is skipped");
+            if (wakeFd >= 0)
+            {
+                close(wakeFd);
+            }
+            return;
+        }
+    }
+
+    TaskTimer_Init();
+    gCallbackCnt = 0;
+
+    /* Sparse set: a few slow periodic tasks; timers set: long timers restarted from their expiry */
+    Scheduler_RegisterTask(housekeepingTask, TIME_INTERVAL_1SEC);
+    Scheduler_RegisterTask(TaskTimer_Tick, TIME_INTERVAL_100MS);
+
+    if (c_TRUE == timersF)
+    {
+        for (timerId = 0; timerId < IDLE_TIMERS_CNT; timerId++)
+        {
+            TaskTimer_Start(&gTimers[timerId], 5000 + ((timerId * 997) % 55000), timerExpiry, &gTimers[timerId]);
+        }
+    }
+    else
+    {
+        Scheduler_RegisterTask(reportTask, TIME_INTERVAL_1MIN);
+    }
+
+    Scheduler_SetWakeupCoalescing((IDLE_STRATEGY_TICK != strategy) ? c_TRUE : c_FALSE);
+    Wait_SetPrecision((IDLE_STRATEGY_PRECISION == strategy) ? &waitConfig : NULL);
+
+    Scheduler_GetLoopStats(&loopStats);
+    startLoops = loopStats.loopIterations;
+    getrusage(RUSAGE_THREAD, &startUsage);
+
+    startTimeNs = Clock_ReadNanoSec();
+    endTimeNs = startTimeNs + ((cU64_t)durationSec * 1000000000ULL);
+    Scheduler_Reset();
+
+    while (Clock_ReadNanoSec() < endTimeNs)
+    {
+        Scheduler_UpdateTick();
+        Scheduler_ExecuteTasksReadyToRun();
+
+        if (IDLE_STRATEGY_EVENTS == strategy)
+        {
+            Scheduler_WaitForEvents(Scheduler_GetDynamicSleep());
+        }
+        else
+        {
+            Utils_SleepNanoSec(Scheduler_GetDynamicSleep());
+        }
+    }
+
+    getrusage(RUSAGE_THREAD, &endUsage);
+    Scheduler_GetLoopStats(&loopStats);
+    runSec = (cDouble_t)(Clock_ReadNanoSec() - startTimeNs) / 1e9;
+
+    Wait_SetPrecision(NULL);
+    Scheduler_DeregisterTask(housekeepingTask);
+    Scheduler_DeregisterTask(reportTask);
+    Scheduler_DeregisterTask(TaskTimer_Tick);
+    TaskTimer_Exit();
+
+    if (wakeFd >= 0)
+    {
+        Scheduler_UnwatchFd(wakeFd);
+        close(wakeFd);
+    }
+
+    cpuNs = (getTimeValNs(&endUsage.ru_utime) + getTimeValNs(&endUsage.ru_stime))
+            - (getTimeValNs(&startUsage.ru_utime) + getTimeValNs(&startUsage.ru_stime));
+
+    pCost->wakeupsPerSec = (cDouble_t)(loopStats.loopIterations - startLoops) / runSec;
+    pCost->voluntaryPerSec = (cDouble_t)(endUsage.ru_nvcsw - startUsage.ru_nvcsw) / runSec;
+    pCost->involuntaryPerSec = (cDouble_t)(endUsage.ru_nivcsw - startUsage.ru_nivcsw) / runSec;
+    pCost->cpuPercent = ((cDouble_t)cpuNs / 1e9) * 100.0 / runSec;
+    pCost->cpuPerWakeupUs = (loopStats.loopIterations != startLoops)
+                            ? ((cDouble_t)cpuNs / 1e3) / (cDouble_t)(loopStats.loopIterations - startLoops) : 0;
+    pCost->callbacks = gCallbackCnt;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Periodic housekeeping task of both sets
+ */
+static void housekeepingTask(void)
+{
+    gCallbackCnt++;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Slow reporting task of sparse set
+ */
+static void reportTask(void)
+{
+    gCallbackCnt++;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Timer of timers set restarts itself
+ * @param userData - Timer
+ */
+static void timerExpiry(void *userData)
+{
+    TaskTimer_t *pTimer = (TaskTimer_t *)userData;
+
+    gCallbackCnt++;
+    TaskTimer_Start(pTimer, 30000, timerExpiry, pTimer);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Readiness callback of watched eventfd, nobody writes it during a run
+ * @param fd - Eventfd
+ * @param events - Ready events
+ * @param ctx - Not used
+ */
+static void drainWakeFd(cI32_t fd, cU32_t events, void *ctx)
+{
+    eventfd_t value;
+
+    (void)events;
+    (void)ctx;
+
+    (void)eventfd_read(fd, &value);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Convert timeval to nanosec
+ * @param pTime - Time
+ * @return Time in nanosec
+ */
+static cU64_t getTimeValNs(const struct timeval *pTime)
+{
+    return ((cU64_t)pTime->tv_sec * 1000000000ULL) + ((cU64_t)pTime->tv_usec * 1000ULL);
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,595 @@
+/*****************************************************************************
+ * @file    schedlat.c
+ * @author  Kshitij Mistry
+ * @brief   Wakeup latency and jitter benchmark of the super loop.
+ *
+ * This file implements a cyclictest like benchmark of the scheduler loop. A task mix is registered
+ * and the usual loop (Scheduler_UpdateTick, Scheduler_ExecuteTasksReadyToRun, sleep for
+ * Scheduler_GetDynamicSleep) runs for a fixed duration with every selected sleep backend in turn.
+ * Every task takes time stamp on entry, release latency is its distance from the last ideal
+ * release (reset time + k * period). Optional stress threads spin on the CPUs as load generator.
+ * Latency summary and histogram of all backends are printed side by side.
+ *
+ * Usage: schedlat.bin [-d <seconds>] [-m light|mixed|busy] [-s <stress threads>] [-r <resolution ms>]
+ *                     [-b <backend>[,<backend>...]] [-c]
+ *        -d  duration of every backend run in seconds (default 10)
+ *        -m  task mix (default mixed)
+ *        -s  number of CPU stress threads (default 0)
+ *        -r  timer resolution in millisec (default 1)
+ *        -b  sleep backends: sleep (Utils_SleepNanoSec), precision (Wait_SetPrecision),
+ *            events (Scheduler_WaitForEvents with an idle eventfd watched, so timeout of the
+ *            readiness backend is measured), default all
+ *        -c  enable wakeup coalescing
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_def.h"
+#include "common_utils.h"
+#include "common_wait.h"
+#include "scheduler.h"
+#include "schedulerIo.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Maximum number of tasks in a mix */
+#define LAT_TASKS_MAX               (8)
+
+/** Maximum number of stress threads */
+#define LAT_STRESS_THREADS_MAX      (64)
+
+/** Histogram buckets, bucket 0 is below 1 us, bucket N is [2^(N-1), 2^N) us, last is open */
+#define LAT_HISTOGRAM_BUCKETS       (18)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Task of a mix
+ */
+typedef struct
+{
+    /** Run interval */
+    TimeInterval_e runInterval;
+
+    /** Period in millisec */
+    cU32_t periodMs;
+
+    /** Busy work done by task in microsec */
+    cU32_t workUs;
+
+}LatTaskDef_t;
+
+/**
+ * @brief   Named task mix
+ */
+typedef struct
+{
+    /** Name given to -m */
+    const cChar *name;
+
+    /** Number of tasks */
+    cU32_t taskCnt;
+
+    /** Tasks */
+    LatTaskDef_t tasks[LAT_TASKS_MAX];
+
+}LatTaskMix_t;
+
+/**
+ * @brief   Sleep backend of the loop
+ */
+typedef enum
+{
+    LAT_BACKEND_SLEEP = 0,
+    LAT_BACKEND_PRECISION,
+    LAT_BACKEND_EVENTS,
+    LAT_BACKEND_MAX
+
+}LatBackend_e;
+
+/**
+ * @brief   Latency samples of one task
+ */
+typedef struct
+{
+    /** Task definition */
+    const LatTaskDef_t *pDef;
+
+    /** Period index of last release */
+    cU64_t lastPeriod;
+
+    /** Periods without release */
+    cU64_t missed;
+
+}LatTask_t;
+
+/**
+ * @brief   Latency result of one backend run
+ */
+typedef struct
+{
+    /** Backend was run */
+    cBool doneF;
+
+    /** Latency samples in nanosec */
+    cU64_t *pSamples;
+
+    /** Number of samples */
+    cU32_t sampleCnt;
+
+    /** Allocated samples */
+    cU32_t sampleMax;
+
+    /** Periods without release */
+    cU64_t missed;
+
+    /** Super loop wakeups */
+    cU64_t loops;
+
+    /** Duration of run in nanosec */
+    cU64_t runNs;
+
+    /** Sample count per histogram bucket */
+    cU64_t histogram[LAT_HISTOGRAM_BUCKETS];
+
+}LatResult_t;
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Task mixes */
+static const LatTaskMix_t gMixes[] = {
+    { "light", 1, { { TIME_INTERVAL_10MS, 10, 0 } } },
+    { "mixed", 5, { { TIME_INTERVAL_10MS, 10, 0 }, { TIME_INTERVAL_20MS, 20, 0 }, { TIME_INTERVAL_20MS, 20, 0 },
+                     { TIME_INTERVAL_100MS, 100, 0 }, { TIME_INTERVAL_100MS, 100, 0 } } },
+    { "busy",  4, { { TIME_INTERVAL_10MS, 10, 50 }, { TIME_INTERVAL_20MS, 20, 200 },
+                     { TIME_INTERVAL_100MS, 100, 2000 }, { TIME_INTERVAL_100MS, 100, 5000 } } },
+};
+
+/** Backend names */
+static const cChar *gBackendNames[LAT_BACKEND_MAX] = { "sleep", "precision", "events" };
+
+/** Tasks of current run */
+static LatTask_t gTasks[LAT_TASKS_MAX];
+
+/** Ideal release time of period 0 of current run */
+static cU64_t gBaseNs = 0;
+
+/** Result of current run */
+static LatResult_t *gResult = NULL;
+
+/** Results of all backends */
+static LatResult_t gResults[LAT_BACKEND_MAX];
+
+/** Stress threads should exit */
+static volatile cBool gStressStopF = c_FALSE;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static void runBackend(LatBackend_e backend, const LatTaskMix_t *pMix, cU32_t resolutionMs, cU32_t durationSec,
+                       cBool coalescingF);
+
+static void latencyTask(void *ctx);
+
+static void drainWakeFd(cI32_t fd, cU32_t events, void *ctx);
+
+static void addSample(LatResult_t *pResult, cU64_t latencyNs);
+
+static void *stressThread(void *arg);
+
+static int compareSamples(const void *pA, const void *pB);
+
+static void printReport(void);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+/**
+ * @brief This is main function of latency benchmark
+ * @param argc - number of arguments
+ * @param **argv - argument list
+ * @return 0 if successfully exited else -1 on error occurs
+ */
+int main(int argc, char **argv)
+{
+    cI32_t opt;
+    cU32_t durationSec = 10;
+    cU32_t resolutionMs = 1;
+    cU32_t stressCnt = 0;
+    cU32_t threadId;
+    cU32_t mixId;
+    cU32_t backendId;
+    cBool coalescingF = c_FALSE;
+    cBool backendF[LAT_BACKEND_MAX] = { c_TRUE, c_TRUE, c_TRUE };
+    const LatTaskMix_t *pMix = &gMixes[1];
+    pthread_t stressThreads[LAT_STRESS_THREADS_MAX];
+    cChar *pToken;
+
+    while (-1 != (opt = getopt(argc, argv, "d:m:s:r:b:c")))
+    {
+        switch (opt)
+        {
+            case 'd': durationSec = (cU32_t)strtoul(optarg, NULL, 10); break;
+            case 's': stressCnt = (cU32_t)strtoul(optarg, NULL, 10); break;
+            case 'r': resolutionMs = (cU32_t)strtoul(optarg, NULL, 10); break;
+            case 'c': coalescingF = c_TRUE; break;
+
+            case 'm':
+                pMix = NULL;
+                for (mixId = 0; mixId < (sizeof(gMixes) / sizeof(gMixes[0])); mixId++)
+                {
+                    if (0 == strcmp(optarg, gMixes[mixId].name))
+                    {
+                        pMix = &gMixes[mixId];
+                    }
+                }
+                break;
+
+            case 'b':
+                memset(backendF, 0, sizeof(backendF));
+                for (pToken = strtok(optarg, ","); NULL != pToken; pToken = strtok(NULL, ","))
+                {
+                    for (backendId = 0; backendId < LAT_BACKEND_MAX; backendId++)
+                    {
+                        if (0 == strcmp(pToken, gBackendNames[backendId]))
+                        {
+                            backendF[backendId] = c_TRUE;
+                        }
+                    }
+                }
+                break;
+
+            default:
+                pMix = NULL;
+                break;
+        }
+    }
+
+    if ((NULL == pMix) || (0 == durationSec) || (stressCnt > LAT_STRESS_THREADS_MAX))
+    {
+        fprintf(stderr, "usage: %s [-d <seconds>] [-m light|mixed|busy] [-s <stress threads>] [-r <resolution ms>]"
+                        " [-b sleep,precision,events] [-c]\n", argv[0]);
+        return (-1);
+    }
+
+    for (threadId = 0; threadId < stressCnt; threadId++)
+    {
+        if (0 != pthread_create(&stressThreads[threadId], NULL, stressThread, NULL))
+        {
+            EPRINT("failed to create stress thread: [id=%u]", threadId);
+            stressCnt = threadId;
+            break;
+        }
+    }
+
+    for (backendId = 0; backendId < LAT_BACKEND_MAX; backendId++)
+    {
+        if (c_TRUE == backendF[backendId])
+        {
+            runBackend((LatBackend_e)backendId, pMix, resolutionMs, durationSec, coalescingF);
+        }
+    }
+
+    gStressStopF = c_TRUE;
+    for (threadId = 0; threadId < stressCnt; threadId++)
+    {
+        pthread_join(stressThreads[threadId], NULL);
+    }
+
+    printf("\nmix %s, %u s per backend, resolution %u ms, %u stress threads, coalescing %s\n\n", pMix->name,
+           durationSec, resolutionMs, stressCnt, (c_TRUE == coalescingF) ? "on" : "off");
+    printReport();
+
+    for (backendId = 0; backendId < LAT_BACKEND_MAX; backendId++)
+    {
+        free(gResults[backendId].pSamples);
+    }
+
+    return (0);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Run task mix on super loop with one sleep backend
+ * @param backend - Sleep backend
+ * @param pMix - Task mix
+ * @param resolutionMs - Timer resolution in millisec
+ * @param durationSec - Duration of run in seconds
+ * @param coalescingF - Enable wakeup coalescing
+ */
+static void runBackend(LatBackend_e backend, const LatTaskMix_t *pMix, cU32_t resolutionMs, cU32_t durationSec,
+                       cBool coalescingF)
+{
+    WaitPrecisionConfig_t waitConfig = { .maxSpinNs = 200000, .maxSpinPercent = 20, .overshootPercentile = 99 };
+    SchedulerLoopStats_t loopStats;
+    cU64_t endTimeNs;
+    cU32_t taskId;
+    cI32_t wakeFd = -1;
+
+    if (c_FALSE == Scheduler_Init(resolutionMs, NULL))
+    {
+        EPRINT("failed to initialize scheduler: [resolution=%u ms]", resolutionMs);
+        return;
+    }
+
+    /* Without a watched fd Scheduler_WaitForEvents falls back to plain sleep */
+    if (LAT_BACKEND_EVENTS == backend)
+    {
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ((wakeFd < 0) || (cStatus_SUCCESS != Scheduler_WatchFd(wakeFd, SCHEDULER_FD_READABLE, drainWakeFd, NULL)))
+        {
+            EPRINT("failed to watch eventfd, events backend is skipped");
+            if (wakeFd >= 0)
+            {
+                close(wakeFd);
+            }
+            return;
+        }
+    }
+
+    gResult = &gResults[backend];
+    gResult->doneF = c_TRUE;
+
+    for (taskId = 0; taskId < pMix->taskCnt; taskId++)
+    {
+        gTasks[taskId].pDef = &pMix->tasks[taskId];
+        gTasks[taskId].lastPeriod = 0;
+        gTasks[taskId].missed = 0;
+        Scheduler_RegisterTaskWithCtx(latencyTask, &gTasks[taskId], pMix->tasks[taskId].runInterval);
+    }
+
+    Scheduler_SetWakeupCoalescing(coalescingF);
+    Wait_SetPrecision((LAT_BACKEND_PRECISION == backend) ? &waitConfig : NULL);
+
+    /* Loop statistics are not cleared by Scheduler_Init */
+    Scheduler_GetLoopStats(&loopStats);
+    gResult->loops = loopStats.loopIterations;
+
+    /* Base is taken before reset, so tick timeline of scheduler never starts before it */
+    gBaseNs = Clock_ReadNanoSec();
+    Scheduler_Reset();
+    endTimeNs = gBaseNs + ((cU64_t)durationSec * 1000000000ULL);
+
+    while (Clock_ReadNanoSec() < endTimeNs)
+    {
+        Scheduler_UpdateTick();
+        Scheduler_ExecuteTasksReadyToRun();
+
+        if (LAT_BACKEND_EVENTS == backend)
+        {
+            Scheduler_WaitForEvents(Scheduler_GetDynamicSleep());
+        }
+        else
+        {
+            Utils_SleepNanoSec(Scheduler_GetDynamicSleep());
+        }
+    }
+
+    Wait_SetPrecision(NULL);
+    Scheduler_GetLoopStats(&loopStats);
+    gResult->loops = loopStats.loopIterations - gResult->loops;
+    gResult->runNs = Clock_ReadNanoSec() - gBaseNs;
+
+    for (taskId = 0; taskId < pMix->taskCnt; taskId++)
+    {
+        gResult->missed += gTasks[taskId].missed;
+        Scheduler_DeregisterTaskWithCtx(latencyTask, &gTasks[taskId]);
+    }
+
+    if (wakeFd >= 0)
+    {
+        Scheduler_UnwatchFd(wakeFd);
+        close(wakeFd);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Readiness callback of watched eventfd, nobody writes it during a run
+ * @param fd - Eventfd
+ * @param events - Ready events
+ * @param ctx - Not used
+ */
+static void drainWakeFd(cI32_t fd, cU32_t events, void *ctx)
+{
+    eventfd_t value;
+
+    (void)events;
+    (void)ctx;
+
+    (void)eventfd_read(fd, &value);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Task of the mix, takes latency sample on entry and does its busy work
+ * @param ctx - Task state (LatTask_t)
+ */
+static void latencyTask(void *ctx)
+{
+    LatTask_t *pTask = (LatTask_t *)ctx;
+    cU64_t curTimeNs = Clock_ReadNanoSec();
+    cU64_t periodNs = (cU64_t)pTask->pDef->periodMs * 1000000ULL;
+    cU64_t sinceBaseNs = curTimeNs - gBaseNs;
+    cU64_t period = sinceBaseNs / periodNs;
+
+    /* Release belongs to last period boundary, skipped boundaries are counted as missed */
+    if (period > (pTask->lastPeriod + 1))
+    {
+        pTask->missed += period - pTask->lastPeriod - 1;
+    }
+
+    pTask->lastPeriod = period;
+    addSample(gResult, sinceBaseNs % periodNs);
+
+    while ((Clock_ReadNanoSec() - curTimeNs) < ((cU64_t)pTask->pDef->workUs * 1000ULL))
+    {
+        continue;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Add latency sample to result
+ * @param pResult - Result of backend run
+ * @param latencyNs - Release latency in nanosec
+ */
+static void addSample(LatResult_t *pResult, cU64_t latencyNs)
+{
+    cU64_t us = latencyNs / 1000;
+    cU32_t bucket = 0;
+    cU64_t *pSamples;
+
+    if (pResult->sampleCnt == pResult->sampleMax)
+    {
+        pSamples = (cU64_t *)realloc(pResult->pSamples, (pResult->sampleMax + 4096) * sizeof(cU64_t));
+        if (NULL == pSamples)
+        {
+            return;
+        }
+
+        pResult->pSamples = pSamples;
+        pResult->sampleMax += 4096;
+    }
+
+    pResult->pSamples[pResult->sampleCnt++] = latencyNs;
+
+    while ((0 != us) && (bucket < (LAT_HISTOGRAM_BUCKETS - 1)))
+    {
+        us >>= 1;
+        bucket++;
+    }
+
+    pResult->histogram[bucket]++;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Stress thread spins till benchmark ends
+ * @param arg - Not used
+ * @return NULL
+ */
+static void *stressThread(void *arg)
+{
+    volatile cU64_t counter = 0;
+
+    (void)arg;
+
+    while (c_FALSE == gStressStopF)
+    {
+        counter++;
+    }
+
+    return (NULL);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Order samples ascending for qsort
+ * @param pA - First sample
+ * @param pB - Second sample
+ * @return Negative, zero or positive as first is less, equal or greater
+ */
+static int compareSamples(const void *pA, const void *pB)
+{
+    cU64_t a = *(const cU64_t *)pA;
+    cU64_t b = *(const cU64_t *)pB;
+
+    return (a < b) ? -1 : ((a > b) ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Print latency summary and histogram of all backend runs side by side
+ */
+static void printReport(void)
+{
+    static const cU32_t percentiles[] = { 50, 90, 99, 999 };
+    LatResult_t *pResult;
+    cU64_t sumNs;
+    cU32_t backendId;
+    cU32_t sampleId;
+    cU32_t percentileId;
+    cU32_t bucket;
+
+    printf("%-10s %9s %7s %9s %9s %9s %9s %9s %9s %10s\n", "BACKEND", "SAMPLES", "MISSED", "LOOPS/s",
+           "AVG(us)", "P50(us)", "P90(us)", "P99(us)", "P99.9(us)", "MAX(us)");
+
+    for (backendId = 0; backendId < LAT_BACKEND_MAX; backendId++)
+    {
+        pResult = &gResults[backendId];
+        if ((c_FALSE == pResult->doneF) || (0 == pResult->sampleCnt))
+        {
+            continue;
+        }
+
+        qsort(pResult->pSamples, pResult->sampleCnt, sizeof(cU64_t), compareSamples);
+
+        for (sumNs = 0, sampleId = 0; sampleId < pResult->sampleCnt; sampleId++)
+        {
+            sumNs += pResult->pSamples[sampleId];
+        }
+
+        printf("%-10s %9u %7" PRIu64 " %9.0f %9.1f", gBackendNames[backendId], pResult->sampleCnt, pResult->missed,
+               (cDouble_t)pResult->loops * 1e9 / (cDouble_t)pResult->runNs, (cDouble_t)sumNs / pResult->sampleCnt / 1e3);
+
+        for (percentileId = 0; percentileId < (sizeof(percentiles) / sizeof(percentiles[0])); percentileId++)
+        {
+            cU32_t scale = (percentiles[percentileId] > 100) ? 1000 : 100;
+
+            printf(" %9.1f", (cDouble_t)pResult->pSamples[((pResult->sampleCnt - 1) * percentiles[percentileId]) / scale] / 1e3);
+        }
+
+        printf(" %10.1f\n", (cDouble_t)pResult->pSamples[pResult->sampleCnt - 1] / 1e3);
+    }
+
+    printf("\n%-14s", "LATENCY(us)");
+    for (backendId = 0; backendId < LAT_BACKEND_MAX; backendId++)
+    {
+        if (c_TRUE == gResults[backendId].doneF)
+        {
+            printf(" %10s", gBackendNames[backendId]);
+        }
+    }
+    printf("\n");
+
+    for (bucket = 0; bucket < LAT_HISTOGRAM_BUCKETS; bucket++)
+    {
+        if (0 == bucket)
+        {
+            printf("%-14s", "< 1");
+        }
+        else if ((LAT_HISTOGRAM_BUCKETS - 1) == bucket)
+        {
+            printf(">= %-11u", 1U << (bucket - 1));
+        }
+        else
+        {
+            printf("%6u - %-6u", 1U << (bucket - 1), 1U << bucket);
+        }
+
+        for (backendId = 0; backendId < LAT_BACKEND_MAX; backendId++)
+        {
+            if (c_TRUE == gResults[backendId].doneF)
+            {
+                printf(" %10" PRIu64, gResults[backendId].histogram[bucket]);
+            }
+        }
+        printf("\n");
+    }
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,627 @@
+/*****************************************************************************
+ * @file    schedreplay.c
+ * @author  Kshitij Mistry
+ * @brief   Replay driver of schedule recordings.
+ *
+ * This file implements offline replay of a recording made by SchedulerRecord_Start. Every recorded
+ * task is registered again with a synthetic callback which consumes the recorded run times in order,
+ * and recorded TaskTimer starts and stops are injected at their recorded time with synthetic expiry
+ * callbacks. Scheduler runs against a virtual clock, which moves only by synthetic run times and
+ * by the sleep asked by scheduler, so replay is deterministic and runs faster than real time.
+ * Start delay (release to start of task) of recording and replay are printed side by side.
+ *
+ * Usage: schedreplay.bin [-d] [-c] [-o] <recording>
+ *        -d  dump events of recording as text and exit
+ *        -c  enable wakeup coalescing in replay
+ *        -o  enable overload control in replay
+ *
+ * Replay runs on the loop thread only. Virtual clock is advanced by synthetic run times, which
+ * serializes tasks, so worker threads can not be modelled.
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_clock.h"
+#include "common_def.h"
+#include "scheduler.h"
+#include "schedulerRecord.h"
+#include "taskTimer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Maximum number of distinct tasks in recording */
+#define REPLAY_TASKS_MAX            (16)
+
+/** Maximum number of distinct timers in recording */
+#define REPLAY_TIMERS_MAX           (256)
+
+/*****************************************************************************
+ * STRUCTURES
+ *****************************************************************************/
+/**
+ * @brief   Recorded run times of one object (task or timer)
+ */
+typedef struct
+{
+    /** Run times in nanosec in recorded order */
+    cU64_t *pRunNs;
+
+    /** Number of run times */
+    cU32_t runCnt;
+
+    /** Allocated entries */
+    cU32_t runMax;
+
+    /** Next run time consumed by replay */
+    cU32_t nextRun;
+
+}ReplayRuns_t;
+
+/**
+ * @brief   Recorded task
+ */
+typedef struct
+{
+    /** Task function in recorded process */
+    cU64_t object;
+
+    /** Application context in recorded process */
+    cU64_t ctx;
+
+    /** Run interval (TimeInterval_e) */
+    cU32_t runInterval;
+
+    /** Task was TaskTimer_Tick */
+    cBool timerTickF;
+
+    /** Recorded run times */
+    ReplayRuns_t runs;
+
+    /** Time of last recorded release */
+    cU64_t lastReleaseNs;
+
+    /** Time of last recorded start */
+    cU64_t lastStartNs;
+
+    /** Recorded releases */
+    cU64_t recReleaseCnt;
+
+    /** Sum of recorded start delays */
+    cU64_t recDelaySumNs;
+
+    /** Max recorded start delay */
+    cU64_t recDelayMaxNs;
+
+    /** Replayed runs */
+    cU64_t repRunCnt;
+
+    /** Sum of replayed start delays */
+    cU64_t repDelaySumNs;
+
+    /** Max replayed start delay */
+    cU64_t repDelayMaxNs;
+
+}ReplayTask_t;
+
+/**
+ * @brief   Recorded TaskTimer
+ */
+typedef struct
+{
+    /** Timer address in recorded process */
+    cU64_t object;
+
+    /** Recorded expiry callback run times */
+    ReplayRuns_t runs;
+
+    /** Timer used in replay */
+    TaskTimer_t timer;
+
+}ReplayTimer_t;
+
+/*****************************************************************************
+ * VARIABLES
+ *****************************************************************************/
+/** Recorded tasks */
+static ReplayTask_t gTasks[REPLAY_TASKS_MAX];
+
+/** Number of recorded tasks */
+static cU32_t gTaskCnt = 0;
+
+/** Recorded timers */
+static ReplayTimer_t gTimers[REPLAY_TIMERS_MAX];
+
+/** Number of recorded timers */
+static cU32_t gTimerCnt = 0;
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static SchedulerRecord_t *loadRecording(const cChar *pPath, SchedulerRecordHeader_t *pHeader, cU32_t *pRecordCnt);
+
+static void dumpRecording(const SchedulerRecordHeader_t *pHeader, const SchedulerRecord_t *pRecords, cU32_t recordCnt);
+
+static void analyzeRecording(const SchedulerRecord_t *pRecords, cU32_t recordCnt);
+
+static ReplayTask_t *findTask(cU64_t object, cU64_t ctx);
+
+static ReplayTimer_t *findTimer(cU64_t object);
+
+static void addRun(ReplayRuns_t *pRuns, cU64_t runNs);
+
+static cU64_t nextRun(ReplayRuns_t *pRuns);
+
+static void accountStartDelay(ReplayTask_t *pTask);
+
+static void replayTask(void *ctx);
+
+static void replayTimerTick(void *ctx);
+
+static void replayTimerExpiry(void *userData);
+
+static void printReport(void);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+/**
+ * @brief This is main function of replay driver
+ * @param argc - number of arguments
+ * @param **argv - argument list
+ * @return 0 if successfully exited else -1 on error occurs
+ */
+int main(int argc, char **argv)
+{
+    cI32_t opt;
+    cBool dumpF = c_FALSE;
+    cBool coalescingF = c_FALSE;
+    cBool overloadF = c_FALSE;
+    cU32_t recordCnt = 0;
+    cU32_t recordId = 0;
+    cU32_t taskId;
+    SchedulerRecordHeader_t header;
+    SchedulerRecord_t *pRecords;
+    ReplayTimer_t *pTimer;
+    SchedulerLoopStats_t loopStats;
+    SchedulerWakeupStats_t wakeupStats;
+
+    while (-1 != (opt = getopt(argc, argv, "dco")))
+    {
+        switch (opt)
+        {
+            case 'd': dumpF = c_TRUE; break;
+            case 'c': coalescingF = c_TRUE; break;
+            case 'o': overloadF = c_TRUE; break;
+            default:
+                fprintf(stderr, "usage: %s [-d] [-c] [-o] <recording>\n", argv[0]);
+                return (-1);
+        }
+    }
+
+    if (optind >= argc)
+    {
+        fprintf(stderr, "usage: %s [-d] [-c] [-o] <recording>\n", argv[0]);
+        return (-1);
+    }
+
+    pRecords = loadRecording(argv[optind], &header, &recordCnt);
+    if (NULL == pRecords)
+    {
+        return (-1);
+    }
+
+    if (c_TRUE == dumpF)
+    {
+        dumpRecording(&header, pRecords, recordCnt);
+        free(pRecords);
+        return (0);
+    }
+
+    analyzeRecording(pRecords, recordCnt);
+
+    /* Scheduler runs on virtual clock which starts at beginning of recording */
+    Clock_SetSource(CLOCK_SOURCE_VIRTUAL);
+    Clock_SetVirtualTime(header.startTimeNs, header.startRealTimeNs);
+
+    if (c_FALSE == Scheduler_Init(header.timerResolutionMs, NULL))
+    {
+        EPRINT("failed to initialize scheduler: [resolution=%u ms]", header.timerResolutionMs);
+        free(pRecords);
+        return (-1);
+    }
+
+    TaskTimer_Init();
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        cStatus_e cStatus;
+
+        /* Timer ticks are replayed by real TaskTimer with synthetic expiry callbacks */
+        cStatus = Scheduler_RegisterTaskWithCtx((c_TRUE == gTasks[taskId].timerTickF) ? replayTimerTick : replayTask,
+                                                &gTasks[taskId], (TimeInterval_e)gTasks[taskId].runInterval);
+
+        if (cStatus_SUCCESS != cStatus)
+        {
+            WPRINT("task is not replayed: [function=0x%" PRIx64 "], [error=%s]", gTasks[taskId].object, ENUM_TO_STR_cStatus(cStatus));
+        }
+    }
+
+    Scheduler_SetWakeupCoalescing(coalescingF);
+
+    if (c_TRUE == overloadF)
+    {
+        SchedulerOverloadConfig_t config = {
+            .windowMs = 1000,
+            .highUtilizationPercent = 90,
+            .lowUtilizationPercent = 60,
+            .maxLatenessMs = 5 * header.timerResolutionMs,
+            .enterWindows = 2,
+            .exitWindows = 5,
+            .maxTickMultiplier = 8,
+        };
+
+        Scheduler_SetOverloadControl(&config);
+    }
+
+    Scheduler_Reset();
+
+    while (recordId < recordCnt)
+    {
+        /* Timers are started and stopped at their recorded time */
+        while ((recordId < recordCnt) && (pRecords[recordId].timeNs <= Clock_ReadNanoSec()))
+        {
+            pTimer = findTimer(pRecords[recordId].object);
+
+            if ((SCHEDULER_RECORD_TIMER_START == pRecords[recordId].type) && (NULL != pTimer))
+            {
+                TaskTimer_Start(&pTimer->timer, pRecords[recordId].arg, replayTimerExpiry, pTimer);
+            }
+            else if ((SCHEDULER_RECORD_TIMER_STOP == pRecords[recordId].type) && (NULL != pTimer))
+            {
+                TaskTimer_Stop(&pTimer->timer);
+            }
+
+            recordId++;
+        }
+
+        Scheduler_UpdateTick();
+        Scheduler_ExecuteTasksReadyToRun();
+        Clock_AdvanceVirtualTime((cU64_t)Scheduler_GetDynamicSleep());
+    }
+
+    printReport();
+
+    Scheduler_GetLoopStats(&loopStats);
+    Scheduler_GetWakeupStats(&wakeupStats);
+    printf("\nreplay: %.3f s, loops %" PRIu64 ", late %" PRIu64 ", max lateness %.3f ms, wakeups %" PRIu64 "\n",
+           (cDouble_t)(Clock_ReadNanoSec() - header.startTimeNs) / 1e9, loopStats.loopIterations,
+           loopStats.lateIterations, (cDouble_t)loopStats.maxLatenessNs / 1e6, wakeupStats.wakeups);
+
+    free(pRecords);
+    return (0);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Read recording into memory
+ * @param pPath - Path of recording
+ * @param pHeader - Structure to which header will get copied
+ * @param pRecordCnt - Number of records read
+ * @return Records, NULL on error
+ */
+static SchedulerRecord_t *loadRecording(const cChar *pPath, SchedulerRecordHeader_t *pHeader, cU32_t *pRecordCnt)
+{
+    FILE *pFile;
+    long fileSize;
+    SchedulerRecord_t *pRecords;
+
+    pFile = fopen(pPath, "rb");
+    if (NULL == pFile)
+    {
+        EPRINT("fail to open recording: [path=%s]", pPath);
+        return (NULL);
+    }
+
+    if ((1 != fread(pHeader, sizeof(SchedulerRecordHeader_t), 1, pFile)) || (SCHEDULER_RECORD_MAGIC != pHeader->magic)
+            || (SCHEDULER_RECORD_VERSION != pHeader->version) || (sizeof(SchedulerRecord_t) != pHeader->recordSize))
+    {
+        EPRINT("recording is not valid or not compatible: [path=%s]", pPath);
+        fclose(pFile);
+        return (NULL);
+    }
+
+    fseek(pFile, 0, SEEK_END);
+    fileSize = ftell(pFile);
+    fseek(pFile, sizeof(SchedulerRecordHeader_t), SEEK_SET);
+
+    *pRecordCnt = (cU32_t)((fileSize - (long)sizeof(SchedulerRecordHeader_t)) / (long)sizeof(SchedulerRecord_t));
+    pRecords = (SchedulerRecord_t *)malloc(((size_t)*pRecordCnt + 1) * sizeof(SchedulerRecord_t));
+    if (NULL == pRecords)
+    {
+        fclose(pFile);
+        return (NULL);
+    }
+
+    *pRecordCnt = (cU32_t)fread(pRecords, sizeof(SchedulerRecord_t), *pRecordCnt, pFile);
+    fclose(pFile);
+
+    return (pRecords);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Print events of recording as text
+ * @param pHeader - Header of recording
+ * @param pRecords - Records
+ * @param recordCnt - Number of records
+ */
+static void dumpRecording(const SchedulerRecordHeader_t *pHeader, const SchedulerRecord_t *pRecords, cU32_t recordCnt)
+{
+    cU32_t recordId;
+    static const cChar *typeStr[] = {"?", "release", "start", "end", "timer-start", "timer-stop", "timer-expiry"};
+
+    printf("resolution %u ms, %u events\n", pHeader->timerResolutionMs, recordCnt);
+
+    for (recordId = 0; recordId < recordCnt; recordId++)
+    {
+        printf("%14.6f ms  %-12s 0x%016" PRIx64 " 0x%016" PRIx64 " %u\n",
+               (cDouble_t)(pRecords[recordId].timeNs - pHeader->startTimeNs) / 1e6,
+               (pRecords[recordId].type <= SCHEDULER_RECORD_TIMER_EXPIRY) ? typeStr[pRecords[recordId].type] : typeStr[0],
+               pRecords[recordId].object, pRecords[recordId].ctx, pRecords[recordId].arg);
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Collect tasks, timers and their run times from recording
+ * @param pRecords - Records
+ * @param recordCnt - Number of records
+ */
+static void analyzeRecording(const SchedulerRecord_t *pRecords, cU32_t recordCnt)
+{
+    cU32_t recordId;
+    const SchedulerRecord_t *pRecord;
+    ReplayTask_t *pTask;
+    ReplayTimer_t *pTimer;
+    cU64_t delayNs;
+
+    for (recordId = 0; recordId < recordCnt; recordId++)
+    {
+        pRecord = &pRecords[recordId];
+
+        switch (pRecord->type)
+        {
+            case SCHEDULER_RECORD_TASK_RELEASE:
+                pTask = findTask(pRecord->object, pRecord->ctx);
+                if ((NULL == pTask) && (gTaskCnt < REPLAY_TASKS_MAX))
+                {
+                    pTask = &gTasks[gTaskCnt++];
+                    pTask->object = pRecord->object;
+                    pTask->ctx = pRecord->ctx;
+                    pTask->runInterval = pRecord->arg & ~SCHEDULER_RECORD_TIMER_TICK;
+                    pTask->timerTickF = (0 != (pRecord->arg & SCHEDULER_RECORD_TIMER_TICK)) ? c_TRUE : c_FALSE;
+                }
+
+                if (NULL != pTask)
+                {
+                    pTask->lastReleaseNs = pRecord->timeNs;
+                    pTask->recReleaseCnt++;
+                }
+                break;
+
+            case SCHEDULER_RECORD_TASK_START:
+                pTask = findTask(pRecord->object, pRecord->ctx);
+                if (NULL != pTask)
+                {
+                    pTask->lastStartNs = pRecord->timeNs;
+                    delayNs = (pRecord->timeNs > pTask->lastReleaseNs) ? (pRecord->timeNs - pTask->lastReleaseNs) : 0;
+                    pTask->recDelaySumNs += delayNs;
+                    if (delayNs > pTask->recDelayMaxNs)
+                    {
+                        pTask->recDelayMaxNs = delayNs;
+                    }
+                }
+                break;
+
+            case SCHEDULER_RECORD_TASK_END:
+                pTask = findTask(pRecord->object, pRecord->ctx);
+                if (NULL != pTask)
+                {
+                    addRun(&pTask->runs, pRecord->timeNs - pTask->lastStartNs);
+                }
+                break;
+
+            case SCHEDULER_RECORD_TIMER_START:
+            case SCHEDULER_RECORD_TIMER_STOP:
+            case SCHEDULER_RECORD_TIMER_EXPIRY:
+                pTimer = findTimer(pRecord->object);
+                if ((NULL == pTimer) && (gTimerCnt < REPLAY_TIMERS_MAX))
+                {
+                    pTimer = &gTimers[gTimerCnt++];
+                    pTimer->object = pRecord->object;
+                }
+
+                if ((NULL != pTimer) && (SCHEDULER_RECORD_TIMER_EXPIRY == pRecord->type))
+                {
+                    addRun(&pTimer->runs, pRecord->arg);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Find recorded task
+ * @param object - Task function in recorded process
+ * @param ctx - Application context in recorded process
+ * @return Task, NULL if not found
+ */
+static ReplayTask_t *findTask(cU64_t object, cU64_t ctx)
+{
+    cU32_t taskId;
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        if ((object == gTasks[taskId].object) && (ctx == gTasks[taskId].ctx))
+        {
+            return (&gTasks[taskId]);
+        }
+    }
+
+    return (NULL);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Find recorded timer
+ * @param object - Timer address in recorded process
+ * @return Timer, NULL if not found
+ */
+static ReplayTimer_t *findTimer(cU64_t object)
+{
+    cU32_t timerId;
+
+    for (timerId = 0; timerId < gTimerCnt; timerId++)
+    {
+        if (object == gTimers[timerId].object)
+        {
+            return (&gTimers[timerId]);
+        }
+    }
+
+    return (NULL);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Append recorded run time
+ * @param pRuns - Run times
+ * @param runNs - Run time in nanosec
+ */
+static void addRun(ReplayRuns_t *pRuns, cU64_t runNs)
+{
+    cU64_t *pRunNs;
+
+    if (pRuns->runCnt == pRuns->runMax)
+    {
+        pRunNs = (cU64_t *)realloc(pRuns->pRunNs, ((pRuns->runMax * 2) + 16) * sizeof(cU64_t));
+        if (NULL == pRunNs)
+        {
+            return;
+        }
+
+        pRuns->pRunNs = pRunNs;
+        pRuns->runMax = (pRuns->runMax * 2) + 16;
+    }
+
+    pRuns->pRunNs[pRuns->runCnt++] = runNs;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Take next recorded run time, recording is repeated when replay runs more often
+ * @param pRuns - Run times
+ * @return Run time in nanosec
+ */
+static cU64_t nextRun(ReplayRuns_t *pRuns)
+{
+    if (0 == pRuns->runCnt)
+    {
+        return (0);
+    }
+
+    return (pRuns->pRunNs[pRuns->nextRun++ % pRuns->runCnt]);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Account start delay of replayed task against release time (snapshot of iteration)
+ * @param pTask - Recorded task
+ */
+static void accountStartDelay(ReplayTask_t *pTask)
+{
+    cU64_t delayNs = Clock_ReadNanoSec() - Clock_NowNanoSec();
+
+    pTask->repRunCnt++;
+    pTask->repDelaySumNs += delayNs;
+    if (delayNs > pTask->repDelayMaxNs)
+    {
+        pTask->repDelayMaxNs = delayNs;
+    }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Synthetic task callback which consumes recorded run time on virtual clock
+ * @param ctx - Recorded task
+ */
+static void replayTask(void *ctx)
+{
+    ReplayTask_t *pTask = (ReplayTask_t *)ctx;
+
+    accountStartDelay(pTask);
+    Clock_AdvanceVirtualTime(nextRun(&pTask->runs));
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Timer tick task of replay, expiry callbacks consume recorded run times
+ * @param ctx - Recorded task
+ */
+static void replayTimerTick(void *ctx)
+{
+    accountStartDelay((ReplayTask_t *)ctx);
+    TaskTimer_Tick();
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Synthetic timer expiry callback which consumes recorded run time on virtual clock
+ * @param userData - Recorded timer
+ */
+static void replayTimerExpiry(void *userData)
+{
+    Clock_AdvanceVirtualTime(nextRun(&((ReplayTimer_t *)userData)->runs));
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Print recorded and replayed statistics of every task
+ */
+static void printReport(void)
+{
+    cU32_t taskId;
+    const ReplayTask_t *pTask;
+
+    printf("%-18s %-18s %8s | %10s %12s %12s | %10s %12s %12s\n", "FUNCTION", "CTX", "INTERVAL",
+           "REC RUNS", "AVG DLY(us)", "MAX DLY(us)", "REP RUNS", "AVG DLY(us)", "MAX DLY(us)");
+
+    for (taskId = 0; taskId < gTaskCnt; taskId++)
+    {
+        pTask = &gTasks[taskId];
+
+        printf("0x%016" PRIx64 " 0x%016" PRIx64 " %8u | %10" PRIu64 " %12.1f %12.1f | %10" PRIu64 " %12.1f %12.1f%s\n",
+               pTask->object, pTask->ctx, pTask->runInterval,
+               pTask->recReleaseCnt,
+               (0 != pTask->runs.runCnt) ? ((cDouble_t)pTask->recDelaySumNs / pTask->runs.runCnt / 1e3) : 0.0,
+               (cDouble_t)pTask->recDelayMaxNs / 1e3,
+               pTask->repRunCnt,
+               (0 != pTask->repRunCnt) ? ((cDouble_t)pTask->repDelaySumNs / pTask->repRunCnt / 1e3) : 0.0,
+               (cDouble_t)pTask->repDelayMaxNs / 1e3,
+               (c_TRUE == pTask->timerTickF) ? "  (TaskTimer_Tick)" : "");
+    }
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/
@@ -0,0 +1,183 @@
+/*****************************************************************************
+ * @file    schedtop.c
+ * @author  Kshitij Mistry
+ * @brief   Top like viewer of scheduler statistics page.
+ *
+ * This file implements a small command line monitor which maps statistics page published by
+ * a scheduler process (SchedulerShm_Open) read only and prints loop and task statistics every
+ * refresh interval. Task functions are printed as addresses of publisher process, those can
+ * be resolved with "addr2line -f -e <binary>".
+ *
+ * Usage: schedtop.bin <shm name> [refresh interval in ms]
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDES
+ *****************************************************************************/
+#include "common_def.h"
+#include "common_utils.h"
+#include "scheduler.h"
+#include "schedulerShm.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * MACROS
+ *****************************************************************************/
+/** Default refresh interval in millisec */
+#define DEFAULT_REFRESH_INTERVAL_MS     (1000)
+
+/** ANSI sequence to clear screen and move cursor to top left */
+#define CLEAR_SCREEN                    "\x1b[H\x1b[2J"
+
+/*****************************************************************************
+ * FUNCTION DECLARATIONS
+ *****************************************************************************/
+static const cChar *intervalToStr(cU32_t runInterval);
+
+static void printPage(const SchedulerShmPage_t *pCur, const SchedulerShmPage_t *pPrev, cU64_t elapsedNs);
+
+/*****************************************************************************
+ * FUNCTION DEFINATIONS
+ *****************************************************************************/
+/**
+ * @brief This is main function of statistics viewer
+ * @param argc - number of arguments
+ * @param **argv - argument list
+ * @return 0 if successfully exited else -1 on error occurs
+ */
+int main(int argc, char **argv)
+{
+    cI32_t fd;
+    cU32_t refreshMs = DEFAULT_REFRESH_INTERVAL_MS;
+    const SchedulerShmPage_t *pPage;
+    SchedulerShmPage_t curPage;
+    SchedulerShmPage_t prevPage;
+    cBool isPrevValid = c_FALSE;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <shm name> [refresh interval ms]\n", argv[0]);
+        return (-1);
+    }
+
+    if (argc > 2)
+    {
+        refreshMs = (cU32_t)strtoul(argv[2], NULL, 10);
+        if (0 == refreshMs)
+        {
+            refreshMs = DEFAULT_REFRESH_INTERVAL_MS;
+        }
+    }
+
+    fd = shm_open(argv[1], O_RDONLY, 0);
+    if (fd < 0)
+    {
+        EPRINT("fail to open shared memory: [name=%s]", argv[1]);
+        return (-1);
+    }
+
+    pPage = (const SchedulerShmPage_t *)mmap(NULL, sizeof(SchedulerShmPage_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (MAP_FAILED == (const void *)pPage)
+    {
+        EPRINT("fail to map shared memory: [name=%s]", argv[1]);
+        return (-1);
+    }
+
+    while (1)
+    {
+        if (c_FALSE == SchedulerShm_ReadSnapshot(pPage, &curPage))
+        {
+            EPRINT("statistics page is not valid or not compatible: [name=%s]", argv[1]);
+        }
+        else
+        {
+            printPage(&curPage, (c_TRUE == isPrevValid) ? &prevPage : NULL,
+                      (c_TRUE == isPrevValid) ? (curPage.updateTimeNs - prevPage.updateTimeNs) : 0);
+            prevPage = curPage;
+            isPrevValid = c_TRUE;
+        }
+
+        Utils_SleepNanoSec((cU64_t)refreshMs * NANO_SECONDS_PER_MILLI_SECOND);
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Print one screen of statistics
+ * @param pCur - Latest snapshot
+ * @param pPrev - Previous snapshot, NULL on first screen
+ * @param elapsedNs - Time between snapshots in nanosec
+ */
+static void printPage(const SchedulerShmPage_t *pCur, const SchedulerShmPage_t *pPrev, cU64_t elapsedNs)
+{
+    cU32_t taskId;
+    cDouble_t loopsPerSec = 0;
+    cDouble_t runsPerSec;
+    cDouble_t avgRunUs;
+
+    if ((NULL != pPrev) && (0 != elapsedNs))
+    {
+        loopsPerSec = ((cDouble_t)(pCur->loopIterations - pPrev->loopIterations) * 1e9) / (cDouble_t)elapsedNs;
+    }
+
+    printf(CLEAR_SCREEN);
+    printf("scheduler pid %d  loops %" PRIu64 " (%.1f/s)  late %" PRIu64 "  lateness last %.3f ms max %.3f ms  timers %" PRIu64 "\n\n",
+           pCur->pid, pCur->loopIterations, loopsPerSec, pCur->lateIterations,
+           (cDouble_t)pCur->lastLatenessNs / 1e6, (cDouble_t)pCur->maxLatenessNs / 1e6, pCur->activeTimers);
+
+    printf("%-18s %-18s %-8s %12s %10s %10s %10s %10s\n",
+           "FUNCTION", "CTX", "PERIOD", "RUNS", "RUNS/S", "LAST(us)", "AVG(us)", "MAX(us)");
+
+    for (taskId = 0; (taskId < pCur->taskCnt) && (taskId < SCHEDULER_SHM_TASKS_MAX); taskId++)
+    {
+        const SchedulerShmTask_t *pTask = &pCur->tasks[taskId];
+
+        runsPerSec = 0;
+        if ((NULL != pPrev) && (0 != elapsedNs) && (pPrev->tasks[taskId].function == pTask->function)
+                && (pTask->runCnt >= pPrev->tasks[taskId].runCnt))
+        {
+            runsPerSec = ((cDouble_t)(pTask->runCnt - pPrev->tasks[taskId].runCnt) * 1e9) / (cDouble_t)elapsedNs;
+        }
+
+        avgRunUs = (0 != pTask->runCnt) ? (((cDouble_t)pTask->totalRunNs / (cDouble_t)pTask->runCnt) / 1e3) : 0;
+
+        printf("0x%016" PRIx64 " 0x%016" PRIx64 " %-8s %12" PRIu64 " %10.1f %10.1f %10.1f %10.1f\n",
+               pTask->function, pTask->ctx, intervalToStr(pTask->runInterval), pTask->runCnt, runsPerSec,
+               (cDouble_t)pTask->lastRunNs / 1e3, avgRunUs, (cDouble_t)pTask->maxRunNs / 1e3);
+    }
+
+    fflush(stdout);
+}
+
+//----------------------------------------------------------------------------
+/**
+ * @brief Convert run interval of task to string
+ * @param runInterval - TimeInterval_e value
+ * @return Printable run interval
+ */
+static const cChar *intervalToStr(cU32_t runInterval)
+{
+    switch (runInterval)
+    {
+        case TIME_INTERVAL_10MS: return ("10ms");
+        case TIME_INTERVAL_20MS: return ("20ms");
+        case TIME_INTERVAL_100MS: return ("100ms");
+        case TIME_INTERVAL_1SEC: return ("1s");
+        case TIME_INTERVAL_1MIN: return ("1min");
+        default: break;
+    }
+
+    return ("-");
+}
+
+/*****************************************************************************
+ * @END OF FILE
+ *****************************************************************************/